@@ -0,0 +1,127 @@
+/*
+  ==============================================================================
+    
+    Benchmarks.cpp
+    Created: 19 Oct 2026 2:15:48pm
+    Author:  Martin Finke
+  
+  ==============================================================================
+*/
+
+#include "TestPrefix.h"
+
+#include "varx/RxCpp/Rx/v2/src/rxcpp/rx.hpp"
+
+#include <atomic>
+#include <thread>
+
+// These test cases are hidden. Run them with the [Benchmark] tag, in a Release build.
+
+namespace {
+	/** Calls `f` from `numThreads` threads at the same time, `numCallsPerThread` times each, and returns the elapsed time in milliseconds. */
+	double measureConcurrently(int numThreads, int numCallsPerThread, const std::function<void(const var&)>& f)
+	{
+		std::vector<std::thread> threads;
+		const double startTime = Time::getMillisecondCounterHiRes();
+		
+		for (int i = 0; i < numThreads; ++i) {
+			threads.emplace_back([numCallsPerThread, &f]() {
+				for (int j = 0; j < numCallsPerThread; ++j)
+					f(j);
+			});
+		}
+		
+		for (auto& thread : threads)
+			thread.join();
+		
+		return Time::getMillisecondCounterHiRes() - startTime;
+	}
+}
+
+
+TEST_CASE("PublishSubject onNext benchmark",
+		  "[.][Benchmark][PublishSubject]")
+{
+	const int numSubscribers = 32;
+	const int numItemsPerThread = 100000;
+	
+	for (int numThreads : {1, 2, 4, 8}) {
+		std::atomic<int64> numReceived(0);
+		
+		// varx::PublishSubject, with a copy-on-write subscriber list
+		PublishSubject subject;
+		DisposeBag disposeBag;
+		for (int i = 0; i < numSubscribers; ++i)
+			subject.subscribe([&](var) { ++numReceived; }).disposedBy(disposeBag);
+		
+		const double subjectTime = measureConcurrently(numThreads, numItemsPerThread, [&](const var& item) { subject.onNext(item); });
+		CHECK(numReceived == int64(numSubscribers) * numThreads * numItemsPerThread);
+		
+		// rxcpp::subjects::subject, which takes a lock on each on_next
+		numReceived = 0;
+		rxcpp::subjects::subject<var> rxcppSubject;
+		rxcpp::composite_subscription rxcppSubscriptions;
+		for (int i = 0; i < numSubscribers; ++i)
+			rxcppSubscriptions.add(rxcppSubject.get_observable().subscribe([&](var) { ++numReceived; }));
+		
+		const auto rxcppSubscriber = rxcppSubject.get_subscriber();
+		const double rxcppTime = measureConcurrently(numThreads, numItemsPerThread, [&](const var& item) { rxcppSubscriber.on_next(item); });
+		CHECK(numReceived == int64(numSubscribers) * numThreads * numItemsPerThread);
+		rxcppSubscriptions.unsubscribe();
+		
+		WARN(numThreads << " thread(s): PublishSubject " << subjectTime << " ms, rxcpp::subjects::subject " << rxcppTime << " ms");
+	}
+}
+
+
+TEST_CASE("BehaviorSubject getLatestItem benchmark",
+		  "[.][Benchmark][BehaviorSubject]")
+{
+	const int numReadsPerThread = 1000000;
+	
+	for (int numReaders : {1, 2, 4, 8}) {
+		BehaviorSubject subject(0);
+		std::atomic<bool> done(false);
+		
+		// One thread keeps writing, while the readers poll the latest item
+		std::thread writer([&]() {
+			for (int i = 0; !done; ++i)
+				subject.onNext(i);
+		});
+		
+		const double readTime = measureConcurrently(numReaders, numReadsPerThread, [&](const var&) { subject.getLatestItem(); });
+		done = true;
+		writer.join();
+		
+		WARN(numReaders << " reader(s), 1 writer: " << (readTime * 1000000.0 / (double(numReaders) * numReadsPerThread)) << " ns per getLatestItem");
+	}
+}
+
+
+TEST_CASE("Reactive<Label> construction benchmark",
+		  "[.][Benchmark][Reactive<Label>]")
+{
+	const int numLabels = 10000;
+	
+	for (bool useProperties : {false, true}) {
+		std::vector<std::unique_ptr<Reactive<Label>>> labels;
+		labels.reserve(numLabels);
+		
+		const double startTime = Time::getMillisecondCounterHiRes();
+		for (int i = 0; i < numLabels; ++i) {
+			labels.emplace_back(new Reactive<Label>());
+			
+			// A typical Label only uses a few of its properties
+			if (useProperties) {
+				labels.back()->rx.text.onNext("Label");
+				labels.back()->rx.font.onNext(toVar(Font(12)));
+			}
+		}
+		const double constructionTime = Time::getMillisecondCounterHiRes() - startTime;
+		
+		labels.clear();
+		const double destructionTime = Time::getMillisecondCounterHiRes() - startTime - constructionTime;
+		
+		WARN(numLabels << " Reactive<Label>s" << (useProperties ? " using text and font" : "") << ": construction " << constructionTime << " ms, destruction " << destructionTime << " ms");
+	}
+}
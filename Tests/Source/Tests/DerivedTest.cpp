@@ -0,0 +1,219 @@
+/*
+  ==============================================================================
+    
+    DerivedTest.cpp
+    Created: 19 Oct 2026 8:31:16pm
+    Author:  Martin Finke
+  
+  ==============================================================================
+*/
+
+#include "TestPrefix.h"
+
+
+TEST_CASE("Derived",
+		  "[Derived]")
+{
+	BehaviorSubject gain(2);
+	int numCalls = 0;
+	Derived doubled({gain}, [&](Array<var> inputs) {
+		numCalls++;
+		return int(inputs[0]) * 2;
+	});
+	Array<var> items;
+	varxCollectItems(doubled.asObservable(), items);
+	
+	IT("computes the initial value") {
+		CHECK(numCalls == 1);
+		CHECK(doubled.getLatestItem() == var(4));
+		varxRequireItems(items, 4);
+	}
+	
+	IT("recomputes when an input changes") {
+		gain.onNext(5);
+		
+		CHECK(numCalls == 2);
+		CHECK(doubled.getLatestItem() == var(10));
+		varxRequireItems(items, 4, 10);
+	}
+	
+	IT("doesn't emit if the computed value doesn't change") {
+		BehaviorSubject number(3);
+		Derived isEven({number}, [](Array<var> inputs) { return int(inputs[0]) % 2 == 0; });
+		Array<var> items;
+		varxCollectItems(isEven.asObservable(), items);
+		
+		number.onNext(5);
+		number.onNext(7);
+		number.onNext(8);
+		
+		varxRequireItems(items, false, true);
+	}
+	
+	IT("doesn't recompute if the input is set to the same value") {
+		gain.onNext(2);
+		
+		CHECK(numCalls == 1);
+		varxRequireItems(items, 4);
+	}
+	
+	IT("recomputes a diamond exactly once per change, without glitches") {
+		Derived plusOne({gain}, [](Array<var> inputs) { return int(inputs[0]) + 1; });
+		int numSumCalls = 0;
+		Array<var> sums;
+		Derived sum({doubled, plusOne}, [&](Array<var> inputs) {
+			numSumCalls++;
+			sums.add(Array<var>({inputs[0], inputs[1]}));
+			return int(inputs[0]) + int(inputs[1]);
+		});
+		Array<var> sumItems;
+		varxCollectItems(sum.asObservable(), sumItems);
+		
+		gain.onNext(10);
+		
+		CHECK(numSumCalls == 2);
+		CHECK(sums.getLast() == var(Array<var>({20, 11})));
+		varxRequireItems(sumItems, 7, 31);
+	}
+	
+	IT("recomputes in topological order with inputs of different depths") {
+		Derived quadrupled({doubled}, [](Array<var> inputs) { return int(inputs[0]) * 2; });
+		Array<var> combinations;
+		Derived combined({gain, quadrupled}, [&](Array<var> inputs) {
+			combinations.add(Array<var>({inputs[0], inputs[1]}));
+			return inputs[1];
+		});
+		
+		gain.onNext(3);
+		
+		CHECK(combinations.size() == 2);
+		REQUIRE(combinations.getLast() == var(Array<var>({3, 12})));
+	}
+	
+	IT("shares a source between Derived values") {
+		Derived a({gain}, [](Array<var> inputs) { return inputs[0]; });
+		Derived b({gain}, [](Array<var> inputs) { return inputs[0]; });
+		int numCombinedCalls = 0;
+		Derived combined({a, b}, [&](Array<var>) { return ++numCombinedCalls; });
+		
+		gain.onNext(100);
+		
+		REQUIRE(numCombinedCalls == 2);
+	}
+	
+	IT("keeps its inputs alive") {
+		auto intermediate = std::make_shared<Derived>(Array<Derived::Input>({gain}), [](Array<var> inputs) { return int(inputs[0]) + 1; });
+		Derived last({*intermediate}, [](Array<var> inputs) { return inputs[0]; });
+		intermediate.reset();
+		
+		gain.onNext(6);
+		
+		REQUIRE(last.getLatestItem() == var(7));
+	}
+}
+
+
+TEST_CASE("Computed",
+		  "[Computed]")
+{
+	BehaviorSubject price(3);
+	BehaviorSubject quantity(2);
+	int numCalls = 0;
+	Computed total([&](const Computed::Reader& reader) {
+		numCalls++;
+		return int(reader.get(price)) * int(reader.get(quantity));
+	});
+	
+	IT("doesn't compute until it's read") {
+		CHECK(numCalls == 0);
+		CHECK(total.getLatestItem() == var(6));
+		REQUIRE(numCalls == 1);
+	}
+	
+	IT("caches its value") {
+		total.getLatestItem();
+		total.getLatestItem();
+		
+		REQUIRE(numCalls == 1);
+	}
+	
+	IT("recomputes lazily after a dependency has changed") {
+		total.getLatestItem();
+		price.onNext(4);
+		quantity.onNext(5);
+		
+		CHECK(numCalls == 1);
+		CHECK(total.getLatestItem() == var(20));
+		REQUIRE(numCalls == 2);
+	}
+	
+	IT("recomputes eagerly while it's observed") {
+		Array<var> items;
+		varxCollectItems(total.asObservable(), items);
+		price.onNext(10);
+		
+		CHECK(numCalls == 2);
+		varxRequireItems(items, 6, 20);
+	}
+	
+	IT("tracks dependencies that change between calls") {
+		BehaviorSubject useQuantity(false);
+		int numConditionalCalls = 0;
+		Computed conditional([&](const Computed::Reader& reader) {
+			numConditionalCalls++;
+			return (reader.get(useQuantity) ? reader.get(quantity) : reader.get(price));
+		});
+		Array<var> items;
+		varxCollectItems(conditional.asObservable(), items);
+		
+		quantity.onNext(7);
+		CHECK(numConditionalCalls == 1);
+		
+		useQuantity.onNext(true);
+		price.onNext(8);
+		CHECK(numConditionalCalls == 2);
+		
+		quantity.onNext(9);
+		CHECK(numConditionalCalls == 3);
+		varxRequireItems(items, 3, 7, 9);
+	}
+	
+	IT("doesn't glitch when it starts to depend on a deeper value during a change") {
+		BehaviorSubject number(1);
+		Derived plusOne({number}, [](Array<var> inputs) { return int(inputs[0]) + 1; });
+		Derived timesTen({plusOne}, [](Array<var> inputs) { return int(inputs[0]) * 10; });
+		Derived deep({timesTen}, [](Array<var> inputs) { return inputs[0]; });
+		Computed conditional([&](const Computed::Reader& reader) {
+			const int n = reader.get(number);
+			return (n % 2 == 0 ? n + int(reader.get(deep)) : n);
+		});
+		Array<var> items;
+		varxCollectItems(conditional.asObservable(), items);
+		
+		number.onNext(2);
+		
+		// Never sees the old value of deep (20) together with the new number
+		varxRequireItems(items, 1, 32);
+	}
+	
+	IT("can depend on other Computed and Derived values") {
+		Derived doubled({price}, [](Array<var> inputs) { return int(inputs[0]) * 2; });
+		Computed sum([&](const Computed::Reader& reader) {
+			return int(reader.get(total)) + int(reader.get(doubled));
+		});
+		
+		CHECK(sum.getLatestItem() == var(12));
+		
+		price.onNext(1);
+		
+		REQUIRE(sum.getLatestItem() == var(4));
+	}
+	
+	IT("can be the input of a Derived value") {
+		Derived label({total}, [](Array<var> inputs) { return "Total: " + inputs[0].toString(); });
+		quantity.onNext(4);
+		
+		CHECK(numCalls == 2);
+		REQUIRE(label.getLatestItem() == var("Total: 12"));
+	}
+}
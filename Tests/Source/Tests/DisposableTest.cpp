@@ -111,4 +111,29 @@ TEST_CASE("DisposeBag",
 		
 		REQUIRE(items.isEmpty());
 	}
+	
+	IT("counts the Disposables whose subscriptions haven't ended") {
+		REQUIRE(disposeBag->size() == 1);
+	}
+	
+	IT("removes a Disposable when its Observable completes") {
+		PublishSubject subject;
+		subject.subscribe([](var) {}).disposedBy(*disposeBag);
+		Observable::just(1).subscribe([](var) {}).disposedBy(*disposeBag);
+		CHECK(disposeBag->size() == 2);
+		
+		subject.onCompleted();
+		
+		REQUIRE(disposeBag->size() == 1);
+	}
+	
+	IT("removes a Disposable when it's disposed") {
+		for (int i = 0; i < 100; ++i) {
+			auto disposable = std::make_shared<Disposable>(observable.subscribe([](var) {}));
+			disposable->disposedBy(*disposeBag);
+			disposable->dispose();
+		}
+		
+		REQUIRE(disposeBag->size() == 1);
+	}
 }
@@ -0,0 +1,231 @@
+/*
+  ==============================================================================
+    
+    FloatBlockTest.cpp
+    Created: 19 Oct 2026 11:40:05am
+    Author:  Martin Finke
+  
+  ==============================================================================
+*/
+
+#include "TestPrefix.h"
+
+
+TEST_CASE("FloatBlock",
+		  "[FloatBlock]")
+{
+	IT("is null when default constructed") {
+		FloatBlock block;
+		CHECK(block.isNull());
+		CHECK(block.getNumSamples() == 0);
+		REQUIRE(block.getReadPointer() == nullptr);
+	}
+	
+	IT("allocates cleared samples") {
+		FloatBlock block(4);
+		CHECK(block.getNumSamples() == 4);
+		CHECK(block.getCapacity() == 4);
+		
+		for (int i = 0; i < block.getNumSamples(); ++i)
+			REQUIRE(block.getReadPointer()[i] == 0.f);
+	}
+	
+	IT("copies samples and changes the number of samples") {
+		FloatBlock block(8);
+		const float samples[] = {0.5f, -0.25f, 1.f};
+		block.copyFrom(samples, 3);
+		
+		CHECK(block.getNumSamples() == 3);
+		CHECK(block.getCapacity() == 8);
+		CHECK(block.getReadPointer()[0] == 0.5f);
+		CHECK(block.getReadPointer()[1] == -0.25f);
+		REQUIRE(block.getReadPointer()[2] == 1.f);
+	}
+	
+	IT("shares the samples between copies") {
+		FloatBlock block(2);
+		FloatBlock copy = block;
+		copy.getWritePointer()[1] = 3.5f;
+		
+		CHECK(copy == block);
+		REQUIRE(block.getReadPointer()[1] == 3.5f);
+	}
+	
+	IT("can be converted to and from var without copying the samples") {
+		FloatBlock block(16);
+		const var wrapped = toVar(block);
+		const FloatBlock unwrapped = fromVar<FloatBlock>(wrapped);
+		
+		CHECK(unwrapped == block);
+		REQUIRE(unwrapped.getReadPointer() == block.getReadPointer());
+	}
+	
+	IT("converts a void var to a null FloatBlock") {
+		REQUIRE(fromVar<FloatBlock>(var()).isNull());
+	}
+	
+	IT("throws when converting a var of a different type") {
+		REQUIRE_THROWS(fromVar<FloatBlock>(var("Not a FloatBlock")));
+	}
+	
+	IT("can be emitted by an Observable") {
+		FloatBlock block(32);
+		PublishSubject subject;
+		Array<FloatBlock> blocks;
+		DisposeBag disposeBag;
+		subject.subscribe([&](var item) { blocks.add(fromVar<FloatBlock>(item)); }).disposedBy(disposeBag);
+		
+		subject.onNext(toVar(block));
+		
+		CHECK(blocks.size() == 1);
+		REQUIRE(blocks[0] == block);
+	}
+}
+
+
+TEST_CASE("FloatBlock kernels",
+		  "[FloatBlock]")
+{
+	// 7 samples, so that both the vectorised part and the remainder are used
+	const float samples[] = {0.5f, -2.f, 1.f, 0.25f, -0.75f, 1.5f, -1.f};
+	FloatBlock block(8);
+	block.copyFrom(samples, 7);
+	
+	IT("calculates the sum") {
+		REQUIRE(block.getSum() == Approx(-0.5f));
+	}
+	
+	IT("calculates the min and max") {
+		CHECK(block.getMin() == -2.f);
+		REQUIRE(block.getMax() == 1.5f);
+	}
+	
+	IT("calculates the peak") {
+		REQUIRE(block.getPeak() == 2.f);
+	}
+	
+	IT("calculates the RMS") {
+		float sumOfSquares = 0;
+		for (float sample : samples)
+			sumOfSquares += sample * sample;
+		
+		REQUIRE(block.getRMS() == Approx(std::sqrt(sumOfSquares / 7)));
+	}
+	
+	IT("calculates the dot product") {
+		FloatBlock ones(10);
+		for (int i = 0; i < ones.getNumSamples(); ++i)
+			ones.getWritePointer()[i] = 1.f;
+		
+		CHECK(block.getDotProduct(ones) == Approx(block.getSum()));
+		REQUIRE(block.getDotProduct(block) == Approx(block.getRMS() * block.getRMS() * 7));
+	}
+	
+	IT("returns 0 for an empty block") {
+		FloatBlock empty;
+		CHECK(empty.getSum() == 0);
+		CHECK(empty.getMin() == 0);
+		CHECK(empty.getMax() == 0);
+		CHECK(empty.getPeak() == 0);
+		CHECK(empty.getRMS() == 0);
+		REQUIRE(empty.getDotProduct(block) == 0);
+	}
+	
+	IT("applies gain and abs in place") {
+		block.applyGain(2.f);
+		CHECK(block.getReadPointer()[1] == -4.f);
+		
+		block.applyAbs();
+		CHECK(block.getReadPointer()[1] == 4.f);
+		REQUIRE(block.getMin() == 0.5f);
+	}
+	
+	IT("creates new blocks with gain and abs from a pool") {
+		FloatBlockPool pool(8);
+		const FloatBlock louder = block.withGain(3.f, pool);
+		const FloatBlock absolute = block.withAbs(pool);
+		
+		CHECK(louder != block);
+		CHECK(louder.getNumSamples() == 7);
+		CHECK(louder.getReadPointer()[5] == 4.5f);
+		CHECK(absolute.getReadPointer()[4] == 0.75f);
+		REQUIRE(block.getReadPointer()[4] == -0.75f);
+	}
+	
+	IT("can be used to meter a block stream") {
+		PublishSubject blocks;
+		Array<var> peaks;
+		DisposeBag disposeBag;
+		blocks.map([](var v) { return fromVar<FloatBlock>(v).getPeak(); }).subscribe([&](var peak) { peaks.add(peak); }).disposedBy(disposeBag);
+		
+		blocks.onNext(toVar(block));
+		
+		varxRequireItems(peaks, 2.f);
+	}
+}
+
+
+TEST_CASE("FloatBlockPool",
+		  "[FloatBlockPool]")
+{
+	FloatBlockPool pool(64, 2);
+	
+	IT("preallocates blocks") {
+		CHECK(pool.getNumBlocks() == 2);
+		REQUIRE(pool.allocate().getCapacity() == 64);
+	}
+	
+	IT("doesn't hand out a block which is still in use") {
+		FloatBlock first = pool.allocate();
+		FloatBlock second = pool.allocate();
+		FloatBlock third = pool.allocate();
+		
+		CHECK(first != second);
+		CHECK(second != third);
+		CHECK(first != third);
+		REQUIRE(pool.getNumBlocks() == 3);
+	}
+	
+	IT("reuses blocks which are not used anymore") {
+		const float* samples = nullptr;
+		{
+			FloatBlock block = pool.allocate();
+			samples = block.getReadPointer();
+		}
+		
+		for (int i = 0; i < 100; ++i) {
+			FloatBlock block = pool.allocate();
+			block.setNumSamples(10);
+		}
+		
+		CHECK(pool.getNumBlocks() == 2);
+		
+		FloatBlock first = pool.allocate();
+		FloatBlock second = pool.allocate();
+		CHECK(first.getNumSamples() == 64);
+		REQUIRE((first.getReadPointer() == samples || second.getReadPointer() == samples));
+	}
+	
+	IT("doesn't reuse a block while it's wrapped in a var") {
+		var wrapped = toVar(pool.allocate());
+		pool.allocate();
+		pool.allocate();
+		CHECK(pool.getNumBlocks() == 2);
+		
+		FloatBlock block = pool.allocate();
+		CHECK(block != fromVar<FloatBlock>(wrapped));
+		
+		wrapped = var();
+		pool.allocate();
+		REQUIRE(pool.getNumBlocks() == 2);
+	}
+	
+	IT("keeps blocks valid after the pool is destroyed") {
+		auto otherPool = std::make_shared<FloatBlockPool>(4);
+		FloatBlock block = otherPool->allocate();
+		otherPool.reset();
+		
+		block.clear();
+		REQUIRE(block.getReadPointer()[3] == 0.f);
+	}
+}
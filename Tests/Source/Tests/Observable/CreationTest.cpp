@@ -13,6 +13,48 @@
 using Catch::Contains;
 
 
+TEST_CASE("Observable::animationFrames",
+		  "[Observable][Observable::animationFrames]")
+{
+	Array<var> items;
+	TickClock& clock = *TickClock::getInstance();
+	const double now = TickClock::getCurrentTime();
+	
+	IT("emits the elapsed time once per frame") {
+		DisposeBag disposeBag;
+		Observable::animationFrames().subscribe([&](const var& item) { items.add(item); }).disposedBy(disposeBag);
+		
+		CHECK(items.isEmpty());
+		
+		clock.triggerTick(now + 1);
+		clock.triggerTick(now + 2);
+		
+		REQUIRE(items.size() == 2);
+		REQUIRE(double(items[1]) - double(items[0]) == Approx(1.0));
+	}
+	
+	IT("stops emitting when unsubscribing") {
+		Observable::animationFrames().take(2).subscribe([&](const var& item) { items.add(item); });
+		
+		for (int i = 1; i <= 3; ++i)
+			clock.triggerTick(now + i);
+		
+		REQUIRE(items.size() == 2);
+	}
+	
+	IT("doesn't emit to a subscription that another subscription has disposed in the same frame") {
+		DisposeBag disposeBag;
+		std::shared_ptr<Disposable> other;
+		Observable::animationFrames().subscribe([&](const var&) { other->dispose(); }).disposedBy(disposeBag);
+		other = std::make_shared<Disposable>(Observable::animationFrames().subscribe([&](const var& item) { items.add(item); }));
+		
+		clock.triggerTick(now + 1);
+		
+		REQUIRE(items.isEmpty());
+	}
+}
+
+
 TEST_CASE("Observable::create",
 		  "[Observable][Observable::create]")
 {
@@ -225,6 +267,90 @@ TEST_CASE("Observable::from",
 }
 
 
+TEST_CASE("Observable::fromFileLines",
+		  "[Observable][Observable::fromFileLines]")
+{
+	TemporaryFile temporaryFile(".txt");
+	const File file = temporaryFile.getFile();
+	const auto writeText = [&](const String& text) {
+		file.replaceWithData(text.toRawUTF8(), text.getNumBytesAsUTF8());
+	};
+	Array<var> items;
+	
+	IT("emits the lines of the file and completes") {
+		writeText("First\nSecond\r\n\nLast\n");
+		bool completed = false;
+		Observable::fromFileLines(file).subscribe([&](var item) { items.add(item); }, [&]() { completed = true; });
+		
+		CHECK(completed);
+		varxRequireItems(items, "First", "Second", "", "Last");
+	}
+	
+	IT("emits the last line if it doesn't end with a line separator") {
+		writeText("First\nLast");
+		varxCollectItems(Observable::fromFileLines(file), items);
+		
+		varxRequireItems(items, "First", "Last");
+	}
+	
+	IT("completes without emitting if the file is empty") {
+		writeText("");
+		bool completed = false;
+		Observable::fromFileLines(file).subscribe([&](var item) { items.add(item); }, [&]() { completed = true; });
+		
+		CHECK(items.isEmpty());
+		REQUIRE(completed);
+	}
+	
+	IT("emits chunks if a chunk size is given") {
+		writeText("1\n2\n3\n4\n5");
+		varxCollectItems(Observable::fromFileLines(file, 2), items);
+		
+		varxRequireItems(items, Array<var>({"1", "2"}), Array<var>({"3", "4"}), Array<var>({"5"}));
+	}
+	
+	IT("stops reading when the subscriber unsubscribes") {
+		writeText("1\n2\n3\n4\n5");
+		varxCollectItems(Observable::fromFileLines(file).take(2), items);
+		
+		varxRequireItems(items, "1", "2");
+	}
+	
+	IT("notifies onError if the file doesn't exist") {
+		bool onErrorCalled = false;
+		Observable::fromFileLines(file.getSiblingFile("doesNotExist.txt")).subscribe([&](var item) { items.add(item); }, [&](Error) {
+			onErrorCalled = true;
+		});
+		
+		CHECK(items.isEmpty());
+		REQUIRE(onErrorCalled);
+	}
+}
+
+
+TEST_CASE("Observable::fromFileRecords",
+		  "[Observable][Observable::fromFileRecords]")
+{
+	TemporaryFile temporaryFile(".txt");
+	const File file = temporaryFile.getFile();
+	const String text("a;;b,c;\r\nd;");
+	file.replaceWithData(text.toRawUTF8(), text.getNumBytesAsUTF8());
+	Array<var> items;
+	
+	IT("splits the file at a single-character delimiter") {
+		varxCollectItems(Observable::fromFileRecords(file, ";"), items);
+		
+		varxRequireItems(items, "a", "", "b,c", "\r\nd");
+	}
+	
+	IT("splits the file at a multi-character delimiter") {
+		varxCollectItems(Observable::fromFileRecords(file, ";\r\n"), items);
+		
+		varxRequireItems(items, "a;;b,c", "d;");
+	}
+}
+
+
 TEST_CASE("Observable::fromValue",
 		  "[Observable][Observable::fromValue]")
 {
@@ -383,6 +509,107 @@ TEST_CASE("Observable::fromValue with a Slider",
 }
 
 
+TEST_CASE("Observable::fromValue with a SynchronousValueSource",
+		  "[Observable][Observable::fromValue]")
+{
+	Value value(new SynchronousValueSource("Initial"));
+	auto source = std::make_shared<Observable>(Observable::fromValue(value));
+	Array<var> items;
+	DisposeBag disposeBag;
+	source->subscribe([&](var item) { items.add(item); }).disposedBy(disposeBag);
+	varxCheckItems(items, "Initial");
+	
+	IT("emits synchronously when the Value is set") {
+		value.setValue("Second");
+		varxCheckItems(items, "Initial", "Second");
+		
+		value.setValue("Third");
+		varxRequireItems(items, "Initial", "Second", "Third");
+	}
+	
+	IT("emits every value if the Value changes rapidly") {
+		for (int i : {1, 2, 3})
+			value.setValue(i);
+		
+		varxRequireItems(items, "Initial", 1, 2, 3);
+	}
+	
+	IT("doesn't emit if the Value is set to the same value") {
+		value.setValue("Initial");
+		value.setValue("Second");
+		value.setValue("Second");
+		varxRunDispatchLoop();
+		
+		varxRequireItems(items, "Initial", "Second");
+	}
+	
+	IT("emits if the Value is set immediately before the Observable is destroyed") {
+		value.setValue("Last");
+		source.reset();
+		
+		varxRequireItems(items, "Initial", "Last");
+	}
+}
+
+
+TEST_CASE("Observable::generate",
+		  "[Observable][Observable::generate]")
+{
+	Array<var> items;
+	
+	IT("emits the generated items and completes") {
+		bool completed = false;
+		Observable::generate(4, [](int i) { return i * i; }).subscribe([&](var item) { items.add(item); }, [&]() { completed = true; });
+		
+		CHECK(completed);
+		varxRequireItems(items, 0, 1, 4, 9);
+	}
+	
+	IT("completes without emitting if numItems is 0") {
+		bool completed = false;
+		Observable::generate(0, [](int i) { return i; }).subscribe([&](var item) { items.add(item); }, [&]() { completed = true; });
+		
+		CHECK(items.isEmpty());
+		REQUIRE(completed);
+	}
+	
+	IT("emits chunks if a chunk size is given") {
+		varxCollectItems(Observable::generate(5, [](int i) { return i; }, 2), items);
+		
+		varxRequireItems(items, Array<var>({0, 1}), Array<var>({2, 3}), Array<var>({4}));
+	}
+	
+	IT("stops generating items when the subscriber unsubscribes") {
+		int numCalls = 0;
+		auto o = Observable::generate(10000, [&](int i) {
+			numCalls++;
+			return i;
+		});
+		varxCollectItems(o.take(3), items);
+		
+		CHECK(numCalls == 3);
+		varxRequireItems(items, 0, 1, 2);
+	}
+	
+	IT("notifies onError if the generator throws") {
+		auto o = Observable::generate(3, [](int i) {
+			if (i == 1)
+				throw std::runtime_error("Generator error");
+			
+			return var(i);
+		});
+		String error;
+		o.subscribe([&](var item) { items.add(item); }, [&](Error e) {
+			try { std::rethrow_exception(e); }
+			catch (const std::exception& exception) { error = exception.what(); }
+		});
+		
+		CHECK(error == "Generator error");
+		varxRequireItems(items, 0);
+	}
+}
+
+
 TEST_CASE("Observable::interval",
 		  "[Observable][Observable::interval]")
 {
@@ -408,6 +635,43 @@ TEST_CASE("Observable::interval",
 }
 
 
+TEST_CASE("Observable::iterate",
+		  "[Observable][Observable::iterate]")
+{
+	auto array = std::make_shared<const Array<var>>(Array<var>({"a", "b", "c", "d", "e"}));
+	Array<var> items;
+	
+	IT("emits the items from the Array") {
+		varxCollectItems(Observable::iterate(array), items);
+		
+		varxRequireItems(items, "a", "b", "c", "d", "e");
+	}
+	
+	IT("emits chunks if a chunk size is given") {
+		varxCollectItems(Observable::iterate(array, 3), items);
+		
+		varxRequireItems(items, Array<var>({"a", "b", "c"}), Array<var>({"d", "e"}));
+	}
+	
+	IT("doesn't copy the Array") {
+		auto o = Observable::iterate(array);
+		varxCollectItems(o, items);
+		varxCollectItems(o, items);
+		
+		CHECK(items.size() == 10);
+		REQUIRE(array.use_count() == 2);
+	}
+	
+	IT("releases the Array when the Observable is destroyed") {
+		auto o = std::make_shared<Observable>(Observable::iterate(array));
+		CHECK(array.use_count() == 2);
+		
+		o.reset();
+		REQUIRE(array.use_count() == 1);
+	}
+}
+
+
 TEST_CASE("Observable::just",
 		  "[Observable][Observable::just]")
 {
@@ -10,6 +10,8 @@
 
 #include "TestPrefix.h"
 
+#include <thread>
+
 
 template<typename Var, typename... Vars>
 var transform(Var v, Vars... vars)
@@ -23,6 +25,59 @@ var transform<var>(var v)
 	return v;
 }
 
+TEST_CASE("Observable::batched",
+		  "[Observable][Observable::batched]")
+{
+	BehaviorSubject minimum(0);
+	BehaviorSubject maximum(1);
+	DisposeBag disposeBag;
+	Array<var> items;
+	varxCollectItems(minimum.combineLatest(maximum).batched(), items);
+	varxCheckItems(items, Array<var>({0, 1}));
+	
+	IT("emits immediately outside of a transaction") {
+		minimum.onNext(10);
+		maximum.onNext(20);
+		
+		varxRequireItems(items, Array<var>({0, 1}), Array<var>({10, 1}), Array<var>({10, 20}));
+	}
+	
+	IT("emits once per transaction") {
+		{
+			Subject::Transaction transaction;
+			minimum.onNext(10);
+			maximum.onNext(20);
+			minimum.onNext(15);
+			
+			CHECK(items.size() == 1);
+		}
+		
+		varxRequireItems(items, Array<var>({0, 1}), Array<var>({15, 20}));
+	}
+	
+	IT("emits once per commit") {
+		Subject::Transaction first;
+		minimum.onNext(5);
+		first.commit();
+		
+		Subject::Transaction second;
+		maximum.onNext(6);
+		second.commit();
+		
+		varxRequireItems(items, Array<var>({0, 1}), Array<var>({5, 1}), Array<var>({5, 6}));
+	}
+	
+	IT("completes when the source completes") {
+		bool completed = false;
+		PublishSubject subject;
+		subject.batched().subscribe([](var) {}, [&]() { completed = true; }).disposedBy(disposeBag);
+		subject.onCompleted();
+		
+		REQUIRE(completed);
+	}
+}
+
+
 TEST_CASE("Observable::combineLatest",
 		  "[Observable][Observable::combineLatest]")
 {
@@ -179,6 +234,143 @@ TEST_CASE("Observable::flatMap",
 		
 		varxRequireItems(items, "hello", "HELLO!", "world", "WORLD!");
 	}
+	
+	CONTEXT("with maxConcurrent") {
+		OwnedArray<PublishSubject> inners;
+		PublishSubject source;
+		auto o = source.flatMap([&](var) {
+			return inners.add(new PublishSubject())->asObservable();
+		}, 2);
+		
+		bool completed = false;
+		DisposeBag disposeBag;
+		o.subscribe([&](var item) { items.add(item); }, [&]() { completed = true; }).disposedBy(disposeBag);
+		
+		IT("subscribes to at most maxConcurrent Observables at the same time") {
+			for (int i = 0; i < 5; i++)
+				source.onNext(i);
+			
+			REQUIRE(inners.size() == 2);
+			
+			inners[0]->onNext("a");
+			inners[0]->onCompleted();
+			REQUIRE(inners.size() == 3);
+			
+			inners[1]->onNext("b");
+			inners[2]->onNext("c");
+			inners[1]->onCompleted();
+			inners[2]->onCompleted();
+			
+			REQUIRE(inners.size() == 5);
+			varxRequireItems(items, "a", "b", "c");
+		}
+		
+		IT("completes when the source and all returned Observables have completed") {
+			source.onNext(1);
+			source.onCompleted();
+			CHECK(!completed);
+			
+			inners[0]->onCompleted();
+			REQUIRE(completed);
+		}
+		
+		IT("handles returned Observables that complete synchronously") {
+			auto o = Observable::range(1, 1000).flatMap([](int i) {
+				return Observable::just(i * 2);
+			}, 3);
+			
+			REQUIRE(o.toArray().size() == 1000);
+		}
+	}
+	
+	IT("doesn't hold its lock while emitting items with maxConcurrent") {
+		PublishSubject source;
+		PublishSubject inner;
+		int numCalls = 0;
+		DisposeBag disposeBag;
+		source.flatMap([&](var) {
+			numCalls++;
+			return inner.asObservable();
+		}, 2).subscribe([&](var item) {
+			// Would deadlock if the item was emitted while holding the lock
+			if (item == var("a"))
+				std::thread([&]() { source.onNext(2); }).join();
+		}).disposedBy(disposeBag);
+		
+		source.onNext(1);
+		inner.onNext("a");
+		
+		REQUIRE(numCalls == 2);
+	}
+}
+
+
+TEST_CASE("Observable::concatMap",
+		  "[Observable][Observable::concatMap]")
+{
+	Array<var> items;
+	
+	OwnedArray<PublishSubject> inners;
+	varxCollectItems(Observable::from({1, 2}).concatMap([&](var) {
+		return inners.add(new PublishSubject())->asObservable();
+	}), items);
+	
+	IT("subscribes to the next returned Observable when the previous one completes") {
+		REQUIRE(inners.size() == 1);
+		
+		inners[0]->onNext("a");
+		inners[0]->onCompleted();
+		REQUIRE(inners.size() == 2);
+		
+		inners[1]->onNext("b");
+		varxRequireItems(items, "a", "b");
+	}
+}
+
+
+TEST_CASE("Observable::groupBy",
+		  "[Observable][Observable::groupBy]")
+{
+	PublishSubject subject;
+	DisposeBag disposeBag;
+	Array<var> keys;
+	std::map<int, Array<var>> groups;
+	bool groupsCompleted = false;
+	
+	subject.groupBy([](int i) { return i % 3; }).subscribe([&](Array<var> group) {
+		const int key = group[0];
+		keys.add(key);
+		
+		fromVar<Observable>(group[1]).subscribe([&groups, key](var item) {
+			groups[key].add(item);
+		}, [&]() {
+			groupsCompleted = true;
+		}).disposedBy(disposeBag);
+	}).disposedBy(disposeBag);
+	
+	IT("emits one Observable per key") {
+		for (int i : {1, 2, 3, 4, 5, 6, 7})
+			subject.onNext(i);
+		
+		varxRequireItems(keys, 1, 2, 0);
+	}
+	
+	IT("routes each item to the group with its key") {
+		for (int i : {1, 2, 3, 4, 5, 6, 7})
+			subject.onNext(i);
+		
+		varxCheckItems(groups[0], 3, 6);
+		varxCheckItems(groups[1], 1, 4, 7);
+		varxRequireItems(groups[2], 2, 5);
+	}
+	
+	IT("completes the groups when the source completes") {
+		subject.onNext(1);
+		CHECK(!groupsCompleted);
+		subject.onCompleted();
+		
+		REQUIRE(groupsCompleted);
+	}
 }
 
 
@@ -253,6 +445,89 @@ TEST_CASE("Interaction between Observable::map and Observable::switchOnNext",
 }
 
 
+TEST_CASE("Observable::parallelMap",
+		  "[Observable][Observable::parallelMap]")
+{
+	auto source = Observable::range(1, 200);
+	Array<var> expected;
+	for (int i = 1; i <= 200; i++)
+		expected.add(i * 3);
+	
+	IT("emits the results in the original order") {
+		// The first item finishes after the second one, so its result must be held back
+		WaitableEvent secondItemMapped(true);
+		auto mapped = source.parallelMap([&](int i) {
+			if (i == 1)
+				secondItemMapped.wait(1000);
+			else if (i == 2)
+				secondItemMapped.signal();
+			
+			return i * 3;
+		}, 2);
+		
+		REQUIRE(mapped.toArray() == expected);
+	}
+	
+	IT("emits all results if the order doesn't have to be preserved") {
+		auto items = source.parallelMap([](int i) { return i * 3; }, 4, false).toArray();
+		CHECK(items.size() == expected.size());
+		
+		for (auto item : expected)
+			REQUIRE(items.contains(item));
+	}
+	
+	IT("never processes more than maxConcurrency items at the same time") {
+		Atomic<int> numRunning;
+		Atomic<int> maxNumRunning;
+		
+		// The first items wait until two of them are running at the same time, so the limit is actually reached
+		WaitableEvent limitReached(true);
+		source.parallelMap([&](int i) {
+			const int running = ++numRunning;
+			if (running > maxNumRunning.get())
+				maxNumRunning = running;
+			
+			if (running == 2)
+				limitReached.signal();
+			else if (i <= 2)
+				limitReached.wait(1000);
+			
+			--numRunning;
+			return i;
+		}, 2).toArray();
+		
+		REQUIRE(maxNumRunning.get() <= 2);
+	}
+	
+	IT("notifies onError if the function throws") {
+		auto mapped = source.parallelMap([](int i) -> var {
+			if (i == 17)
+				throw std::runtime_error("Error");
+			
+			return i;
+		});
+		
+		bool onErrorCalled = false;
+		mapped.toArray([&](Error) { onErrorCalled = true; });
+		
+		REQUIRE(onErrorCalled);
+	}
+	
+	IT("doesn't run queued items after unsubscribing") {
+		Atomic<int> numCalls;
+		
+		// With one item at a time, the next item is only started after the previous result has been emitted. So no item can be running when take() unsubscribes.
+		auto items = source.parallelMap([&](int i) {
+			++numCalls;
+			return i;
+		}, 1).take(3).toArray();
+		
+		CHECK(items.size() == 3);
+		REQUIRE(numCalls.get() == 3);
+	}
+}
+
+
 TEST_CASE("Observable::reduce",
 		  "[Observable][Observable::reduce]")
 {
@@ -270,6 +545,51 @@ TEST_CASE("Observable::reduce",
 }
 
 
+TEST_CASE("Observable::sampleOnFrame",
+		  "[Observable][Observable::sampleOnFrame]")
+{
+	PublishSubject subject;
+	Array<var> items;
+	varxCollectItems(subject.sampleOnFrame(), items);
+	
+	IT("emits only the latest item with the next frame") {
+		subject.onNext(1);
+		subject.onNext(2);
+		subject.onNext(3);
+		
+		CHECK(items.isEmpty());
+		
+		varxRunDispatchLoop(40);
+		
+		varxRequireItems(items, 3);
+	}
+	
+	IT("doesn't emit anything if there was no new item") {
+		subject.onNext("Foo");
+		varxRunDispatchLoop(40);
+		varxRunDispatchLoop(40);
+		
+		varxRequireItems(items, "Foo");
+	}
+	
+	IT("emits the pending item before completing") {
+		bool completed = false;
+		DisposeBag disposeBag;
+		subject.sampleOnFrame().subscribe([](var){}, [&]() { completed = true; }).disposedBy(disposeBag);
+		
+		subject.onNext("Bar");
+		subject.onCompleted();
+		
+		CHECK(!completed);
+		
+		varxRunDispatchLoop(40);
+		
+		CHECK(completed);
+		varxRequireItems(items, "Bar");
+	}
+}
+
+
 TEST_CASE("Observable::scan",
 		  "[Observable][Observable::scan]")
 {
@@ -343,6 +663,28 @@ TEST_CASE("Observable::startWith",
 }
 
 
+TEST_CASE("Observable::switchMap",
+		  "[Observable][Observable::switchMap]")
+{
+	Array<var> items;
+	PublishSubject source;
+	OwnedArray<PublishSubject> inners;
+	varxCollectItems(source.switchMap([&](var) {
+		return inners.add(new PublishSubject())->asObservable();
+	}), items);
+	
+	IT("emits items only from the most recently returned Observable") {
+		source.onNext(1);
+		inners[0]->onNext("first");
+		source.onNext(2);
+		inners[0]->onNext("ignored");
+		inners[1]->onNext("second");
+		
+		varxRequireItems(items, "first", "second");
+	}
+}
+
+
 TEST_CASE("Observable::takeLast",
 		  "[Observable][Observable::takeLast]")
 {
@@ -414,6 +756,72 @@ TEST_CASE("Observable::takeWhile",
 }
 
 
+TEST_CASE("Observable::tweenTo",
+		  "[Observable][Observable::tweenTo]")
+{
+	Array<var> items;
+	TickClock& clock = *TickClock::getInstance();
+	
+	IT("animates a double to the target and completes") {
+		bool completed = false;
+		DisposeBag disposeBag;
+		const double now = TickClock::getCurrentTime();
+		Observable::just(2.0).tweenTo(10.0, RelativeTime::seconds(10), Easing::easeInOut())
+			.subscribe([&](const var& item) { items.add(item); }, [&]() { completed = true; })
+			.disposedBy(disposeBag);
+		
+		CHECK(items.isEmpty());
+		
+		clock.triggerTick(now + 2);
+		clock.triggerTick(now + 5);
+		
+		REQUIRE(items.size() == 2);
+		REQUIRE(double(items[0]) > 2.0);
+		REQUIRE(double(items[1]) > double(items[0]));
+		REQUIRE(double(items[1]) < 10.0);
+		CHECK(!completed);
+		
+		clock.triggerTick(now + 20);
+		
+		REQUIRE(completed);
+		REQUIRE(items.getLast() == var(10.0));
+	}
+	
+	IT("animates a Colour to the target") {
+		DisposeBag disposeBag;
+		const double now = TickClock::getCurrentTime();
+		Observable::just(toVar(Colours::black)).tweenTo(Colours::white, RelativeTime::seconds(10))
+			.subscribe([&](const var& item) { items.add(item); })
+			.disposedBy(disposeBag);
+		
+		clock.triggerTick(now + 5);
+		
+		REQUIRE(items.size() == 1);
+		const Colour halfway = fromVar<Colour>(items.getFirst());
+		REQUIRE(halfway.getBrightness() > 0.0f);
+		REQUIRE(halfway.getBrightness() < 1.0f);
+		
+		clock.triggerTick(now + 20);
+		
+		REQUIRE(fromVar<Colour>(items.getLast()) == Colours::white);
+	}
+	
+	IT("starts a new animation when a new item is emitted") {
+		PublishSubject subject;
+		varxCollectItems(subject.tweenTo(1.0, RelativeTime::seconds(10)), items);
+		
+		subject.onNext(0.0);
+		clock.triggerTick(TickClock::getCurrentTime() + 5);
+		subject.onNext(-100.0);
+		items.clear();
+		clock.triggerTick(TickClock::getCurrentTime() + 0.5);
+		
+		REQUIRE(items.size() == 1);
+		REQUIRE(double(items.getFirst()) < -90.0);
+	}
+}
+
+
 TEST_CASE("Observable::withLatestFrom",
 		  "[Observable][Observable::withLatestFrom]")
 {
@@ -72,4 +72,15 @@ TEST_CASE("Observable::observeOn",
 		
 		varxRequireItems(items, 2, 4, 6);
 	}
+	
+	IT("can schedule to the next frame") {
+		auto onFrame = observable.observeOn(Scheduler::frame());
+		varxCollectItems(onFrame, items);
+		
+		CHECK(items.isEmpty());
+		
+		varxRunDispatchLoop(40);
+		
+		varxRequireItems(items, 1, 2, 3);
+	}
 }
@@ -10,6 +10,8 @@
 
 #include "TestPrefix.h"
 
+#include <thread>
+
 
 TEST_CASE("Reactive<Value> conversion",
 		  "[Reactive<Value>][ValueExtension]")
@@ -66,6 +68,103 @@ TEST_CASE("Reactive<Value> Observable",
 	}
 }
 
+
+TEST_CASE("Reactive<ValueTree>",
+		  "[Reactive<ValueTree>][ValueTreeExtension]")
+{
+	ValueTree source("Root");
+	source.setProperty("name", "Initial", nullptr);
+	Reactive<ValueTree> tree(source);
+	Array<var> items;
+	
+	CONTEXT("property") {
+		varxCollectItems(tree.rx.property("name"), items);
+		
+		IT("initially emits the current property value") {
+			varxRequireItems(items, "Initial");
+		}
+		
+		IT("emits synchronously when the property changes") {
+			source.setProperty("name", "Second", nullptr);
+			source.setProperty("name", "Third", nullptr);
+			
+			varxRequireItems(items, "Initial", "Second", "Third");
+		}
+		
+		IT("changes the property when calling onNext") {
+			tree.rx.property("name").onNext("Changed");
+			
+			CHECK(source["name"] == "Changed");
+			varxRequireItems(items, "Initial", "Changed");
+		}
+		
+		IT("doesn't emit when other properties change") {
+			source.setProperty("other", 3, nullptr);
+			
+			varxRequireItems(items, "Initial");
+		}
+		
+		IT("emits void when the property is removed") {
+			source.removeProperty("name", nullptr);
+			
+			CHECK(!source.hasProperty("name"));
+			varxRequireItems(items, "Initial", var());
+		}
+		
+		IT("removes the property when pushing void") {
+			tree.rx.property("name").onNext(var());
+			
+			CHECK(!source.hasProperty("name"));
+			varxRequireItems(items, "Initial", var());
+		}
+		
+		IT("emits when only the type of the property changes") {
+			source.setProperty("name", 1, nullptr);
+			source.setProperty("name", "1", nullptr);
+			
+			CHECK(source["name"].isString());
+			varxRequireItems(items, "Initial", 1, "1");
+		}
+		
+		IT("doesn't add a property that doesn't exist") {
+			tree.rx.property("missing");
+			
+			REQUIRE(!source.hasProperty("missing"));
+		}
+		
+		IT("returns the same subject for the same property") {
+			tree.rx.property("name").onNext("Foo");
+			
+			REQUIRE(tree.rx.property("name").getLatestItem() == "Foo");
+		}
+	}
+	
+	CONTEXT("children") {
+		varxCollectItems(tree.rx.childAdded, items);
+		Array<var> removedItems;
+		varxCollectItems(tree.rx.childRemoved, removedItems);
+		const ValueTree child("Child");
+		
+		IT("emits added and removed children") {
+			source.addChild(child, -1, nullptr);
+			source.removeChild(child, nullptr);
+			
+			REQUIRE(items.size() == 1);
+			REQUIRE(fromVar<ValueTree>(items.getFirst()) == child);
+			REQUIRE(removedItems.size() == 1);
+			REQUIRE(fromVar<ValueTree>(removedItems.getFirst()) == child);
+		}
+		
+		IT("doesn't emit for grandchildren") {
+			source.addChild(child, -1, nullptr);
+			items.clear();
+			ValueTree(child).addChild(ValueTree("Grandchild"), -1, nullptr);
+			
+			REQUIRE(items.isEmpty());
+		}
+	}
+}
+
 TEST_CASE("Reactive<Component>",
 		  "[Reactive<Component>][ComponentExtension]")
 {
@@ -92,6 +191,38 @@ TEST_CASE("Reactive<Component>",
 			REQUIRE(component.isVisible() == visible);
 		}
 	}
+	
+	IT("emits the current visibility when subscribing after a change") {
+		Reactive<Component> other;
+		Array<var> otherItems;
+		auto disposable = std::make_shared<Disposable>(other.rx.visible.subscribe([&](var visible) { otherItems.add(visible); }));
+		other.setVisible(true);
+		disposable->dispose();
+		
+		// Nobody observes the Component at this point
+		other.setVisible(false);
+		varxCollectItems(other.rx.visible, otherItems);
+		
+		varxRequireItems(otherItems, false, true, false);
+	}
+	
+	IT("keeps the latest item up to date without subscribers") {
+		Reactive<Component> other;
+		other.setVisible(true);
+		
+		REQUIRE(other.rx.visible.getLatestItem() == var(true));
+	}
+	
+	IT("disposes its subscriptions when destroyed") {
+		auto other = std::make_shared<Reactive<Component>>();
+		Observer visible = other->rx.visible.asObserver();
+		Observer colour = other->rx.colour(Label::textColourId);
+		other.reset();
+		
+		// Must not access the destroyed Component
+		visible.onNext(false);
+		colour.onNext(toVar(Colours::red));
+	}
 }
 
 
@@ -150,6 +281,21 @@ TEST_CASE("Reactive<Button>",
 		}
 	}
 	
+	IT("adds the click listener on the message thread when subscribed from another thread") {
+		DisposeBag disposeBag;
+		
+		std::thread([&]() {
+			button.rx.clicked.subscribe([&](var item) { items.add(item); }).disposedBy(disposeBag);
+		}).join();
+		
+		// The listener is added asynchronously
+		varxRunDispatchLoop(20);
+		button.triggerClick();
+		varxRunDispatchLoop();
+		
+		varxRequireItems(items, var::undefined());
+	}
+	
 	CONTEXT("buttonState") {
 		varxCollectItems(button.rx.buttonState, items);
 		
@@ -248,6 +394,41 @@ TEST_CASE("Reactive<Button>",
 				}
 			}
 		}
+		
+		IT("returns a working Observer when called again with the same colour id") {
+			for (auto colour : {Colours::red, Colours::green, Colours::blue}) {
+				button.rx.colour(TextButton::buttonColourId).onNext(toVar(colour));
+				
+				REQUIRE(button.findColour(TextButton::buttonColourId) == colour);
+			}
+		}
+		
+		IT("doesn't add subscriptions when called repeatedly") {
+			struct Extension : public ComponentExtension
+			{
+				using ComponentExtension::ComponentExtension;
+				size_t getNumSubscriptions() const { return disposeBag.size(); }
+			};
+			Component component;
+			Extension extension(component);
+			const size_t numSubscriptions = extension.getNumSubscriptions();
+			
+			for (int i = 0; i < 100; ++i)
+				extension.colour(Label::textColourId).onNext(toVar(i % 2 == 0 ? Colours::red : Colours::blue));
+			
+			CHECK(component.findColour(Label::textColourId) == Colours::blue);
+			REQUIRE(extension.getNumSubscriptions() == numSubscriptions);
+		}
+		
+		IT("still sets the colour after a source has completed") {
+			DisposeBag disposeBag;
+			Observable::just(toVar(Colours::red)).subscribe(button.rx.colour(TextButton::buttonColourId)).disposedBy(disposeBag);
+			CHECK(button.findColour(TextButton::buttonColourId) == Colours::red);
+			
+			button.rx.colour(TextButton::buttonColourId).onNext(toVar(Colours::blue));
+			
+			REQUIRE(button.findColour(TextButton::buttonColourId) == Colours::blue);
+		}
 	}
 }
 
@@ -412,6 +593,13 @@ TEST_CASE("Reactive<Label>",
 			
 			REQUIRE(label.getFont() == font2);
 		}
+		
+		IT("changes the Label font when subscribed to an Observable") {
+			const Observer observer = label.rx.font;
+			Observable::just(toVar(font1)).subscribe(observer);
+			
+			REQUIRE(label.getFont() == font1);
+		}
 	}
 	
 	CONTEXT("justificationType") {
@@ -567,6 +755,86 @@ TEST_CASE("Reactive<Label>",
 			REQUIRE(!label.doesLossOfFocusDiscardChanges());
 		}
 	}
+	
+	CONTEXT("coalescing updates per frame") {
+		label.rx.setCoalescesUpdatesPerFrame(true);
+		const Font font(18.43, Font::bold);
+		
+		IT("applies only the latest item on the next frame") {
+			label.rx.text.onNext("Foo");
+			label.rx.text.onNext("Bar");
+			label.rx.font.onNext(toVar(font));
+			
+			CHECK(label.getText().isEmpty());
+			CHECK(label.getFont() != font);
+			
+			varxRunDispatchLoop(100);
+			
+			CHECK(label.getText() == "Bar");
+			REQUIRE(label.getFont() == font);
+		}
+		
+		IT("updates the latest item of the text property immediately") {
+			label.rx.text.onNext("Foo");
+			
+			CHECK(label.getText().isEmpty());
+			REQUIRE(label.rx.text.getLatestItem() == "Foo");
+		}
+		
+		IT("applies pending items immediately when disabling it") {
+			label.rx.text.onNext("Foo");
+			label.rx.setCoalescesUpdatesPerFrame(false);
+			
+			REQUIRE(label.getText() == "Foo");
+		}
+		
+		IT("applies items immediately after disabling it") {
+			label.rx.setCoalescesUpdatesPerFrame(false);
+			label.rx.text.onNext("Foo");
+			
+			REQUIRE(label.getText() == "Foo");
+		}
+		
+		IT("doesn't apply a change from the Label again on the next frame") {
+			Array<var> textItems;
+			varxCollectItems(label.rx.text, textItems);
+			label.setText("Changed", sendNotificationSync);
+			label.setText("X", dontSendNotification);
+			
+			varxRunDispatchLoop(100);
+			
+			CHECK(label.rx.text.getLatestItem() == "Changed");
+			REQUIRE(label.getText() == "X");
+		}
+		
+		IT("discards a pending item when the Label changes") {
+			Array<var> textItems;
+			varxCollectItems(label.rx.text, textItems);
+			label.rx.text.onNext("Pending");
+			label.setText("Changed", sendNotificationSync);
+			
+			varxRunDispatchLoop(100);
+			
+			REQUIRE(label.getText() == "Changed");
+		}
+		
+		IT("applies the items in the order in which they were pushed") {
+			// The label must be on the screen to show an editor (asserts otherwise)
+			TestWindow::getInstance().addAndMakeVisible(label);
+			label.setText("Original", dontSendNotification);
+			label.showEditor();
+			label.getCurrentTextEditor()->setText("Edited", false);
+			
+			label.rx.discardChangesWhenHidingEditor.onNext(true);
+			label.rx.showEditor.onNext(false);
+			label.rx.discardChangesWhenHidingEditor.onNext(false);
+			label.rx.setCoalescesUpdatesPerFrame(false);
+			
+			// The editor has been hidden before the discard setting was changed back
+			CHECK(label.getCurrentTextEditor() == nullptr);
+			REQUIRE(label.getText() == "Original");
+		}
+	}
 }
 
 
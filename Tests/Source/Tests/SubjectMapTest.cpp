@@ -0,0 +1,140 @@
+/*
+  ==============================================================================
+    
+    SubjectMapTest.cpp
+    Created: 19 Oct 2026 4:48:30pm
+    Author:  Martin Finke
+  
+  ==============================================================================
+*/
+
+#include "TestPrefix.h"
+
+
+TEST_CASE("SubjectMap",
+		  "[SubjectMap]")
+{
+	SubjectMap map;
+	DisposeBag disposeBag;
+	Array<var> items;
+	
+	IT("is empty after being created") {
+		CHECK(map.size() == 0);
+		CHECK(!map.contains("gain"));
+		REQUIRE(map.getValue("gain").isUndefined());
+	}
+	
+	IT("stores values by key") {
+		map.setValue("gain", 0.5);
+		map.setValue("pan", -1);
+		map.setValue("gain", 0.7);
+		
+		CHECK(map.size() == 2);
+		CHECK(map.contains("pan"));
+		CHECK(map.getValue("gain") == var(0.7));
+		REQUIRE(map.getValue("pan") == var(-1));
+	}
+	
+	IT("emits the latest value on subscribe") {
+		map.setValue("gain", 0.5);
+		varxCollectItems(map.observe("gain"), items);
+		
+		varxRequireItems(items, 0.5);
+	}
+	
+	IT("doesn't emit on subscribe if the key has no value") {
+		varxCollectItems(map.observe("gain"), items);
+		CHECK(items.isEmpty());
+		
+		map.setValue("gain", 0.5);
+		varxRequireItems(items, 0.5);
+	}
+	
+	IT("only emits changes for the observed key") {
+		varxCollectItems(map.observe("gain"), items);
+		map.setValue("pan", 0.1);
+		map.setValue("gain", 1);
+		map.setValue("cutoff", 440);
+		map.setValue("gain", 2);
+		
+		varxRequireItems(items, 1, 2);
+	}
+	
+	IT("doesn't emit if the value doesn't change") {
+		varxCollectItems(map.observe("gain"), items);
+		map.setValue("gain", 1);
+		map.setValue("gain", 1);
+		map.setValue("gain", 1.0);
+		
+		varxRequireItems(items, 1, 1.0);
+	}
+	
+	IT("emits to multiple subscribers of the same key") {
+		Array<var> otherItems;
+		varxCollectItems(map.observe("gain"), items);
+		varxCollectItems(map.observe("gain"), otherItems);
+		map.setValue("gain", 3);
+		
+		CHECK(otherItems == Array<var>({3}));
+		varxRequireItems(items, 3);
+	}
+	
+	IT("stops emitting when the subscriber is disposed") {
+		auto disposable = map.observe("gain").subscribe([&](var item) { items.add(item); });
+		map.setValue("gain", 1);
+		disposable.dispose();
+		map.setValue("gain", 2);
+		
+		varxRequireItems(items, 1);
+	}
+	
+	IT("sets a value through an Observer") {
+		varxCollectItems(map.observe("gain"), items);
+		Observable::from({0.1, 0.2}).subscribe(map.observer("gain")).disposedBy(disposeBag);
+		
+		CHECK(map.getValue("gain") == var(0.2));
+		varxRequireItems(items, 0.1, 0.2);
+	}
+	
+	IT("returns a snapshot of all values") {
+		map.setValue("gain", 0.5);
+		map.setValue("pan", -1);
+		const NamedValueSet values = map.getValues();
+		map.setValue("gain", 0.1);
+		
+		CHECK(values.size() == 2);
+		CHECK(values["gain"] == var(0.5));
+		REQUIRE(values["pan"] == var(-1));
+	}
+	
+	IT("sets multiple values at once") {
+		varxCollectItems(map.observe("gain"), items);
+		NamedValueSet values;
+		values.set("gain", 0.5);
+		values.set("pan", 0.25);
+		map.setValues(values);
+		
+		CHECK(map.size() == 2);
+		CHECK(map.getValue("pan") == var(0.25));
+		varxRequireItems(items, 0.5);
+	}
+	
+	IT("shares the values between copies") {
+		SubjectMap copy = map;
+		copy.setValue("gain", 0.5);
+		
+		REQUIRE(map.getValue("gain") == var(0.5));
+	}
+	
+	IT("handles many keys") {
+		for (int i = 0; i < 2000; ++i)
+			map.setValue(Identifier("param" + String(i)), i);
+		
+		varxCollectItems(map.observe("param1234"), items);
+		map.setValue("param1234", -1);
+		
+		CHECK(map.size() == 2000);
+		CHECK(map.getValue("param1999") == var(1999));
+		varxRequireItems(items, 1234, -1);
+	}
+}
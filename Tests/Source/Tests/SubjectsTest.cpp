@@ -10,6 +10,9 @@
 
 #include "TestPrefix.h"
 
+#include <atomic>
+#include <thread>
+
 
 TEST_CASE("BehaviorSubject",
 		  "[Subject][BehaviorSubject]")
@@ -71,6 +74,57 @@ TEST_CASE("BehaviorSubject",
 		subject.onCompleted();
 		subject.onCompleted();
 	}
+	
+	IT("returns a consistent latest item while other threads push items") {
+		std::atomic<bool> done(false);
+		std::thread writer([&]() {
+			for (int i = 0; i < 10000; ++i)
+				subject.onNext(i % 2 == 0 ? var("Even") : var(Array<var>({1, 2, 3})));
+			
+			done = true;
+		});
+		
+		bool allConsistent = true;
+		while (!done) {
+			const var latest = subject.getLatestItem();
+			allConsistent &= (latest == "Initial Item" || latest == "Even" || latest == var(Array<var>({1, 2, 3})));
+		}
+		writer.join();
+		
+		REQUIRE(allConsistent);
+	}
+	
+	IT("doesn't deadlock when two subjects feed each other from two threads") {
+		BehaviorSubject first(0);
+		BehaviorSubject second(0);
+		DisposeBag disposeBag;
+		
+		// Even items are forwarded to the other subject as odd items, which aren't forwarded again
+		first.subscribe([&](int i) {
+			if (i % 2 == 0)
+				second.onNext(i + 1);
+		}).disposedBy(disposeBag);
+		second.subscribe([&](int i) {
+			if (i % 2 == 0)
+				first.onNext(i + 1);
+		}).disposedBy(disposeBag);
+		
+		std::thread other([&]() {
+			for (int i = 0; i < 10000; i += 2)
+				second.onNext(i);
+		});
+		
+		for (int i = 0; i < 10000; i += 2)
+			first.onNext(i);
+		
+		other.join();
+		
+		// Both threads have finished delivering, so this is delivered synchronously
+		first.onNext(10000);
+		
+		REQUIRE(first.getLatestItem() == var(10000));
+		REQUIRE(second.getLatestItem() == var(10001));
+	}
 }
 
 
@@ -125,6 +179,51 @@ TEST_CASE("PublishSubject",
 		varxRequireItems(items, 12345);
 	}
 	
+	IT("doesn't emit to a subscriber that has been disposed") {
+		Array<var> otherItems;
+		auto disposable = subject.subscribe([&](var item) { otherItems.add(item); });
+		subject.onNext(1);
+		disposable.dispose();
+		subject.onNext(2);
+		
+		CHECK(otherItems == Array<var>({1}));
+		varxRequireItems(items, 1, 2);
+	}
+	
+	IT("can be subscribed to while emitting an item") {
+		Array<var> laterItems;
+		bool subscribed = false;
+		subject.subscribe([&](var) {
+			if (subscribed)
+				return;
+			
+			subscribed = true;
+			subject.subscribe([&](var item) { laterItems.add(item); }).disposedBy(disposeBag);
+			subject.onNext("Inner");
+		}).disposedBy(disposeBag);
+		subject.onNext("Outer");
+		
+		varxRequireItems(laterItems, "Inner");
+	}
+	
+	IT("emits items pushed from multiple threads") {
+		std::atomic<int> numReceived(0);
+		subject.subscribe([&](var) { ++numReceived; }).disposedBy(disposeBag);
+		
+		std::vector<std::thread> threads;
+		for (int i = 0; i < 4; ++i) {
+			threads.emplace_back([&]() {
+				for (int j = 0; j < 1000; ++j)
+					subject.onNext(j);
+			});
+		}
+		
+		for (auto& thread : threads)
+			thread.join();
+		
+		REQUIRE(numReceived == 4000);
+	}
+	
 	IT("emits an error when calling onError") {
 		PublishSubject subject;
 		bool onErrorCalled = false;
@@ -213,6 +312,77 @@ TEST_CASE("ReplaySubject",
 		varxRequireItems(items, 7, 28, 3, 6);
 	}
 	
+	IT("keeps the order when the limited buffer wraps around multiple times") {
+		ReplaySubject subject(3);
+		for (int i = 0; i < 10; ++i)
+			subject.onNext(i);
+		
+		Array<var> items;
+		varxCollectItems(subject, items);
+		
+		varxRequireItems(items, 7, 8, 9);
+	}
+	
+	IT("doesn't remember any items with a buffer size of 0") {
+		ReplaySubject subject(0);
+		subject.onNext(1);
+		
+		Array<var> items;
+		varxCollectItems(subject, items);
+		subject.onNext(2);
+		
+		varxRequireItems(items, 2);
+	}
+	
+	IT("remembers many items with an unlimited buffer") {
+		ReplaySubject subject;
+		for (int i = 0; i < 100; ++i)
+			subject.onNext(i);
+		
+		Array<var> items;
+		varxCollectItems(subject, items);
+		
+		CHECK(items.size() == 100);
+		CHECK(items.getFirst() == var(0));
+		REQUIRE(items.getLast() == var(99));
+	}
+	
+	IT("only replays items within the time window") {
+		ReplaySubject subject(ReplaySubject::MaxBufferSize, RelativeTime::seconds(0.05));
+		subject.onNext("Old");
+		Thread::sleep(100);
+		subject.onNext("New");
+		
+		Array<var> items;
+		varxCollectItems(subject, items);
+		
+		varxRequireItems(items, "New");
+	}
+	
+	IT("limits the number of items with a time window") {
+		ReplaySubject subject(2, RelativeTime::seconds(10));
+		for (int i = 0; i < 5; ++i)
+			subject.onNext(i);
+		
+		Array<var> items;
+		varxCollectItems(subject, items);
+		
+		varxRequireItems(items, 3, 4);
+	}
+	
+	IT("replays the items and then the completion") {
+		ReplaySubject subject;
+		subject.onNext(1);
+		subject.onCompleted();
+		
+		Array<var> items;
+		bool completed = false;
+		subject.subscribe([&](var item) { items.add(item); }, [&]() { completed = true; }).disposedBy(disposeBag);
+		
+		CHECK(completed);
+		varxRequireItems(items, 1);
+	}
+	
 	IT("changes value when changing the Observer") {
 		subject.asObserver().onNext(32.51);
 		subject.asObserver().onNext(3.0);
@@ -265,3 +435,198 @@ TEST_CASE("ReplaySubject",
 		}
 	}
 }
+
+
+TEST_CASE("ConflatingSubject",
+		  "[Subject][ConflatingSubject]")
+{
+	ConflatingSubject subject;
+	DisposeBag disposeBag;
+	
+	// Subscribe to the subject's Observable
+	Array<var> items;
+	varxCollectItems(subject.asObservable(), items);
+	
+	IT("does not emit an item if nothing has been pushed") {
+		varxRunDispatchLoop(20);
+		
+		REQUIRE(items.isEmpty());
+	}
+	
+	IT("does not emit synchronously") {
+		subject.onNext(1);
+		
+		REQUIRE(items.isEmpty());
+	}
+	
+	IT("emits only the latest item of a burst") {
+		for (int i = 0; i < 100; ++i)
+			subject.onNext(i);
+		
+		varxRunDispatchLoop(20);
+		
+		varxRequireItems(items, 99);
+	}
+	
+	IT("emits the latest item of each burst") {
+		subject.onNext("First");
+		subject.onNext("Second");
+		varxRunDispatchLoop(20);
+		
+		subject.onNext("Third");
+		varxRunDispatchLoop(20);
+		
+		varxRequireItems(items, "Second", "Third");
+	}
+	
+	IT("emits the pending item before completing") {
+		bool completed = false;
+		subject.subscribe([](var) {}, [&]() { completed = true; }).disposedBy(disposeBag);
+		subject.onNext(17);
+		subject.onCompleted();
+		
+		CHECK(completed);
+		varxRequireItems(items, 17);
+	}
+	
+	IT("emits after destruction, if there's still an Observer pushing items") {
+		auto subject = std::make_shared<ConflatingSubject>();
+		auto observer = subject->asObserver();
+		
+		Array<var> items;
+		varxCollectItems(subject->asObservable(), items);
+		subject.reset();
+		observer.onNext(12345);
+		varxRunDispatchLoop(20);
+		
+		varxRequireItems(items, 12345);
+	}
+	
+	IT("can emit on a background thread") {
+		ConflatingSubject subject(Scheduler::newThread());
+		WaitableEvent emitted;
+		Array<var> items;
+		subject.subscribe([&](var item) {
+			items.add(item);
+			
+			if (item == var(2))
+				emitted.signal();
+		}).disposedBy(disposeBag);
+		
+		subject.onNext(1);
+		subject.onNext(2);
+		CHECK(emitted.wait(1000));
+		
+		REQUIRE(items.getLast() == var(2));
+	}
+}
+
+
+TEST_CASE("Subject::Transaction",
+		  "[Subject][Subject::Transaction]")
+{
+	BehaviorSubject behaviorSubject("Initial");
+	Array<var> behaviorItems;
+	varxCollectItems(behaviorSubject, behaviorItems);
+	
+	IT("defers items until the transaction is committed") {
+		Subject::Transaction transaction;
+		behaviorSubject.onNext(1);
+		varxCheckItems(behaviorItems, "Initial");
+		
+		transaction.commit();
+		
+		varxRequireItems(behaviorItems, "Initial", 1);
+	}
+	
+	IT("changes the latest item immediately") {
+		Subject::Transaction transaction;
+		behaviorSubject.onNext("Changed");
+		
+		REQUIRE(behaviorSubject.getLatestItem() == "Changed");
+	}
+	
+	IT("emits only the latest item per Subject") {
+		{
+			Subject::Transaction transaction;
+			for (int i = 0; i < 10; ++i)
+				behaviorSubject.onNext(i);
+		}
+		
+		varxRequireItems(behaviorItems, "Initial", 9);
+	}
+	
+	IT("commits when it's destroyed") {
+		{
+			Subject::Transaction transaction;
+			behaviorSubject.onNext("Item");
+		}
+		
+		varxRequireItems(behaviorItems, "Initial", "Item");
+	}
+	
+	IT("emits immediately after committing") {
+		Subject::Transaction transaction;
+		transaction.commit();
+		behaviorSubject.onNext("Item");
+		
+		varxRequireItems(behaviorItems, "Initial", "Item");
+	}
+	
+	IT("joins an outer transaction") {
+		Subject::Transaction outer;
+		{
+			Subject::Transaction inner;
+			behaviorSubject.onNext("Item");
+			inner.commit();
+			varxCheckItems(behaviorItems, "Initial");
+		}
+		varxCheckItems(behaviorItems, "Initial");
+		
+		outer.commit();
+		varxRequireItems(behaviorItems, "Initial", "Item");
+	}
+	
+	IT("emits a deferred item before completing") {
+		bool completed = false;
+		DisposeBag disposeBag;
+		behaviorSubject.subscribe([](var) {}, [&]() { completed = true; }).disposedBy(disposeBag);
+		
+		Subject::Transaction transaction;
+		behaviorSubject.onNext("Item");
+		behaviorSubject.onCompleted();
+		
+		CHECK(completed);
+		varxRequireItems(behaviorItems, "Initial", "Item");
+	}
+	
+	IT("doesn't defer items of a PublishSubject") {
+		PublishSubject publishSubject;
+		Array<var> publishItems;
+		varxCollectItems(publishSubject, publishItems);
+		
+		Subject::Transaction transaction;
+		publishSubject.onNext("Event");
+		
+		varxRequireItems(publishItems, "Event");
+	}
+	
+	IT("doesn't defer items of a ReplaySubject") {
+		ReplaySubject replaySubject;
+		Array<var> replayItems;
+		varxCollectItems(replaySubject, replayItems);
+		
+		Subject::Transaction transaction;
+		replaySubject.onNext(1);
+		replaySubject.onNext(2);
+		
+		varxRequireItems(replayItems, 1, 2);
+	}
+	
+	IT("doesn't defer items on other threads") {
+		Subject::Transaction transaction;
+		std::thread([&]() { behaviorSubject.onNext("Other thread"); }).join();
+		
+		varxRequireItems(behaviorItems, "Initial", "Other thread");
+	}
+}
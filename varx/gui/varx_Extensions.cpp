@@ -8,11 +8,86 @@
   ==============================================================================
 */
 
+#include "../rx/internal/varx_Observer_Impl.h"
+#include "../rx/internal/varx_Subjects_Impl.h"
+
 using std::placeholders::_1;
 
+/**
+	The items that are waiting for the next tick of the TickClock, if the extension coalesces updates. There's at most one item per property. They're applied in the order in which they were pushed: If a property gets a new item, its update moves to the end. So setters that depend on each other (e.g. LabelExtension::discardChangesWhenHidingEditor and showEditor) see the same order as without coalescing.
+ */
+struct ExtensionBase::Staging : public std::enable_shared_from_this<ExtensionBase::Staging>
+{
+	typedef std::shared_ptr<const std::function<void(const var&)>> Setter;
+	
+	struct Update
+	{
+		int property;
+		var item;
+		Setter setter;
+	};
+	
+	Staging()
+	: isEnabled(false),
+	  isScheduled(false),
+	  numProperties(0) {}
+	
+	/** Returns false if the extension doesn't coalesce updates. In this case, the caller should apply the item immediately. */
+	bool stage(int property, const var& item, const Setter& setter, const std::function<var()>& getCurrentItem)
+	{
+		if (!isEnabled)
+			return false;
+		
+		const ScopedLock sl(lock);
+		auto it = std::find_if(updates.begin(), updates.end(), [property](const Update& update) { return update.property == property; });
+		
+		// The remembered item is replaced, either by the new item or by the component's current state
+		if (it != updates.end())
+			updates.erase(it);
+		
+		// The component is in this state already (e.g. the item came from its listener), which is newer than a remembered item
+		if (getCurrentItem != nullptr && getCurrentItem() == item)
+			return true;
+		
+		updates.push_back(Update{property, item, setter});
+		
+		if (!isScheduled) {
+			isScheduled = true;
+			std::weak_ptr<Staging> weakThis = shared_from_this();
+			TickClock::getInstance()->callOnNextTick([weakThis]() {
+				if (auto strongThis = weakThis.lock())
+					strongThis->flush();
+			});
+		}
+		
+		return true;
+	}
+	
+	void flush()
+	{
+		std::vector<Update> pendingUpdates;
+		
+		{
+			const ScopedLock sl(lock);
+			pendingUpdates.swap(updates);
+			isScheduled = false;
+		}
+		
+		for (auto& update : pendingUpdates)
+			(*update.setter)(update.item);
+	}
+	
+	CriticalSection lock;
+	std::atomic<bool> isEnabled;
+	bool isScheduled;
+	std::atomic<int> numProperties;
+	std::vector<Update> updates;
+};
+
 ExtensionBase::ExtensionBase()
 : _deallocated(1),
-  deallocated(_deallocated) {}
+  deallocated(_deallocated),
+  staging(std::make_shared<Staging>()) {}
 
 ExtensionBase::~ExtensionBase()
 {
@@ -20,12 +95,145 @@ ExtensionBase::~ExtensionBase()
 	_deallocated.onCompleted();
 }
 
+void ExtensionBase::setCoalescesUpdatesPerFrame(bool shouldCoalesce)
+{
+	staging->isEnabled = shouldCoalesce;
+	
+	if (!shouldCoalesce)
+		staging->flush();
+}
+
+std::function<void(const var&)> ExtensionBase::coalesced(const std::function<void(const var&)>& setter, const std::function<var()>& getCurrentItem) const
+{
+	const Staging::Setter sharedSetter = std::make_shared<const std::function<void(const var&)>>(setter);
+	const std::weak_ptr<Staging> weakStaging = staging;
+	const int property = staging->numProperties++;
+	
+	return [weakStaging, property, sharedSetter, getCurrentItem](const var& item) {
+		if (auto strongStaging = weakStaging.lock()) {
+			if (!strongStaging->stage(property, item, sharedSetter, getCurrentItem))
+				(*sharedSetter)(item);
+		}
+	};
+}
+
+Observer ExtensionBase::makeObserver(const std::function<void(const var&)>& onNext)
+{
+	return Observer(std::make_shared<Observer::Impl>(rxcpp::make_subscriber<var>(rxcpp::make_observer_dynamic<var>(onNext, [](Error) {
+		// Not handled, like Observable::subscribe without an onError handler
+		std::terminate();
+	}, []() {}))));
+}
+
+struct ExtensionBase::ListenerRegistration::State : public std::enable_shared_from_this<ExtensionBase::ListenerRegistration::State>
+{
+	State(const std::function<void()>& addListener, const std::function<void()>& removeListener)
+	: addListener(addListener),
+	  removeListener(removeListener),
+	  numObserved(0),
+	  isRegistered(false),
+	  isEnabled(true) {}
+	
+	void setObserved(size_t index, bool observed, int64 sequenceNumber)
+	{
+		{
+			const ScopedLock sl(lock);
+			
+			// The count callback is called outside of the SubscriberList's lock, so an older count may arrive late
+			if (sequenceNumber < nextSequenceNumbers[index])
+				return;
+			
+			nextSequenceNumbers[index] = sequenceNumber + 1;
+			
+			if (!isEnabled || observedSubjects[index] == observed)
+				return;
+			
+			observedSubjects[index] = observed;
+			numObserved += (observed ? 1 : -1);
+		}
+		
+		if (MessageManager::getInstance()->isThisTheMessageThread()) {
+			updateRegistration();
+		}
+		else {
+			std::weak_ptr<State> weakThis = shared_from_this();
+			MessageManager::getInstance()->callAsync([weakThis]() {
+				if (auto strongThis = weakThis.lock())
+					strongThis->updateRegistration();
+			});
+		}
+	}
+	
+	/** Adds or removes the listener, if needed. Must be called on the message thread. */
+	void updateRegistration()
+	{
+		jassert(MessageManager::getInstance()->isThisTheMessageThread());
+		
+		const ScopedLock sl(lock);
+		const bool shouldBeRegistered = (isEnabled && numObserved > 0);
+		if (shouldBeRegistered == isRegistered)
+			return;
+		
+		isRegistered = shouldBeRegistered;
+		
+		if (isRegistered)
+			addListener();
+		else
+			removeListener();
+	}
+	
+	CriticalSection lock;
+	const std::function<void()> addListener;
+	const std::function<void()> removeListener;
+	std::vector<bool> observedSubjects;
+	std::vector<int64> nextSequenceNumbers;
+	int numObserved;
+	bool isRegistered;
+	bool isEnabled;
+};
+
+ExtensionBase::ListenerRegistration::ListenerRegistration(const std::function<void()>& addListener, const std::function<void()>& removeListener)
+: state(std::make_shared<State>(addListener, removeListener)) {}
+
+ExtensionBase::ListenerRegistration::~ListenerRegistration()
+{
+	{
+		const ScopedLock sl(state->lock);
+		state->isEnabled = false;
+	}
+	
+	// Components are destroyed on the message thread, so the listener can be removed right away
+	state->updateRegistration();
+}
+
+void ExtensionBase::ListenerRegistration::observe(const Subject& subject)
+{
+	const std::shared_ptr<SubscriberList> subscribers = subject.impl->getSubscriberList();
+	jassert(subscribers != nullptr);
+	
+	size_t index;
+	
+	{
+		const ScopedLock sl(state->lock);
+		index = state->observedSubjects.size();
+		state->observedSubjects.push_back(false);
+		state->nextSequenceNumbers.push_back(0);
+	}
+	
+	const size_t numOwnSubscriptions = subscribers->size();
+	const std::weak_ptr<State> weakState = state;
+	subscribers->setCountCallback([weakState, index, numOwnSubscriptions](size_t numSubscribers, int64 sequenceNumber) {
+		if (auto strongState = weakState.lock())
+			strongState->setObserved(index, numSubscribers > numOwnSubscriptions, sequenceNumber);
+	});
+}
+
 ValueExtension::ValueExtension(const Value& inputValue)
 : subject(inputValue.getValue()),
   value(inputValue)
 {
 	value.addListener(this);
-	subject.takeUntil(deallocated).subscribe(std::bind(&Value::setValue, value, _1));
+	subject.subscribe(std::bind(&Value::setValue, value, _1)).disposedBy(disposeBag);
 }
 
 void ValueExtension::valueChanged(Value&)
@@ -36,27 +244,117 @@ void ValueExtension::valueChanged(Value&)
 }
 
 
+size_t ValueTreeExtension::IdentifierHash::operator()(const Identifier& identifier) const
+{
+	// Identifiers are pooled, so equal Identifiers share the same characters
+	return std::hash<const void*>()(identifier.getCharPointer().getAddress());
+}
+
+ValueTreeExtension::ValueTreeExtension(const ValueTree& inputTree)
+: childAdded(_childAdded),
+  childRemoved(_childRemoved),
+  tree(inputTree)
+{
+	tree.addListener(this);
+}
+
+BehaviorSubject ValueTreeExtension::property(const Identifier& name) const
+{
+	const ScopedLock sl(propertiesLock);
+	
+	auto it = properties.find(name);
+	if (it != properties.end())
+		return it->second;
+	
+	const BehaviorSubject subject(tree[name]);
+	properties.emplace(name, subject);
+	
+	// Skip the initial item, to avoid adding a void property
+	subject.skip(1).subscribe([this, name](const var& newValue) {
+		ValueTree target(tree);
+		
+		// Void removes the property. An item that came from the tree (through valueTreePropertyChanged) is already there, so it's not written back.
+		if (newValue.isVoid())
+			target.removeProperty(name, nullptr);
+		else if (!target.hasProperty(name) || !newValue.equalsWithSameType(target[name]))
+			target.setProperty(name, newValue, nullptr);
+	}).disposedBy(disposeBag);
+	
+	return subject;
+}
+
+void ValueTreeExtension::valueTreePropertyChanged(ValueTree& changedTree, const Identifier& name)
+{
+	if (changedTree != tree)
+		return;
+	
+	const BehaviorSubject* subject = nullptr;
+	
+	{
+		const ScopedLock sl(propertiesLock);
+		auto it = properties.find(name);
+		
+		// Properties are never erased, and unordered_map doesn't move its elements, so the pointer stays valid
+		if (it != properties.end())
+			subject = &it->second;
+	}
+	
+	// Emit outside of the lock, so that subscribers can call property()
+	const var newValue = tree[name];
+	if (subject != nullptr && !newValue.equalsWithSameType(subject->getLatestItem()))
+		subject->onNext(newValue);
+}
+
+void ValueTreeExtension::valueTreeChildAdded(ValueTree& parent, ValueTree& child)
+{
+	if (parent == tree)
+		_childAdded.onNext(toVar(child));
+}
+
+void ValueTreeExtension::valueTreeChildRemoved(ValueTree& parent, ValueTree& child, int)
+{
+	if (parent == tree)
+		_childRemoved.onNext(toVar(child));
+}
+
+void ValueTreeExtension::valueTreeChildOrderChanged(ValueTree&, int, int) {}
+
+void ValueTreeExtension::valueTreeParentChanged(ValueTree&) {}
+
+
 ComponentExtension::ComponentExtension(Component& parent)
 : parent(parent),
   visible(parent.isVisible())
 {
-	Array<Subject> colourSubjects;
-	storeSubject = [colourSubjects](const Subject& subject) mutable { colourSubjects.add(subject); };
-	
 	parent.addComponentListener(this);
-	visible.takeUntil(deallocated).subscribe(std::bind(&Component::setVisible, &parent, _1));
+	
+	visible.subscribe(coalesced(std::bind(&Component::setVisible, &parent, _1), [&parent]() {
+		return var(parent.isVisible());
+	})).disposedBy(disposeBag);
+}
+
+ComponentExtension::~ComponentExtension()
+{
+	parent.removeComponentListener(this);
 }
 
 Observer ComponentExtension::colour(int colourId) const
 {
-	PublishSubject subject;
+	const ScopedLock sl(colourLock);
 	
-	subject.takeUntil(deallocated).subscribe([colourId, this](const var& colour) {
-		this->parent.setColour(colourId, fromVar<Colour>(colour));
-	});
+	// There are just a few colourIds per Component, so a linear search is fast
+	int index = colourIds.indexOf(colourId);
 	
-	storeSubject(subject);
-	return subject;
+	if (index < 0) {
+		index = colourIds.size();
+		colourIds.add(colourId);
+		colourSetters.push_back(coalesced([colourId, this](const var& colour) {
+			this->parent.setColour(colourId, fromVar<Colour>(colour));
+		}));
+	}
+	
+	// A new Observer for each call, because an Observer that has received onCompleted can't be used anymore
+	return makeObserver(colourSetters[index]);
 }
 
 void ComponentExtension::componentVisibilityChanged(Component& component)
@@ -72,26 +370,48 @@ ButtonExtension::ButtonExtension(Button& parent)
   clicked(_clicked),
   buttonState(parent.getState()),
   toggleState(parent.getToggleState()),
-  text(_text),
-  tooltip(_tooltip)
+  text(makeObserver(coalesced(std::bind(&Button::setButtonText, &parent, _1)))),
+  tooltip(makeObserver(coalesced(std::bind(&Button::setTooltip, &parent, _1)))),
+  clickListener(_clicked),
+  clickListenerRegistration([this, &parent]() {
+	  parent.addListener(&clickListener);
+  }, [this, &parent]() {
+	  parent.removeListener(&clickListener);
+  })
 {
 	parent.addListener(this);
 	
-	_text.takeUntil(deallocated).subscribe(std::bind(&Button::setButtonText, &parent, _1));
-	_tooltip.takeUntil(deallocated).subscribe(std::bind(&Button::setTooltip, &parent, _1));
-	
-	buttonState.takeUntil(deallocated).subscribe([&parent](const var& v) {
+	buttonState.subscribe(coalesced([&parent](const var& v) {
 		parent.setState(fromVar<Button::ButtonState>(v));
-	});
+	}, [&parent]() {
+		return var(parent.getState());
+	})).disposedBy(disposeBag);
 	
-	toggleState.takeUntil(deallocated).subscribe([&parent](bool toggled) {
+	toggleState.subscribe(coalesced([&parent](bool toggled) {
 		parent.setToggleState(toggled, sendNotificationSync);
-	});
+	}, [&parent]() {
+		return var(parent.getToggleState());
+	})).disposedBy(disposeBag);
+	
+	clickListenerRegistration.observe(_clicked);
+}
+
+ButtonExtension::~ButtonExtension()
+{
+	static_cast<Button&>(parent).removeListener(this);
+}
+
+ButtonExtension::ClickListener::ClickListener(const PublishSubject& clicked)
+: clicked(clicked) {}
+
+void ButtonExtension::ClickListener::buttonClicked(Button *)
+{
+	clicked.onNext(var::undefined());
 }
 
 void ButtonExtension::buttonClicked(Button *)
 {
-	_clicked.onNext(var::undefined());
+	// Clicks are emitted by the ClickListener
 }
 
 void ButtonExtension::buttonStateChanged(Button *button)
@@ -106,17 +426,12 @@ void ButtonExtension::buttonStateChanged(Button *button)
 
 ImageComponentExtension::ImageComponentExtension(ImageComponent& parent)
 : ComponentExtension(parent),
-  image(_image),
-  imagePlacement(_imagePlacement)
-{
-	_image.takeUntil(deallocated).subscribe([&parent](const var& image) {
-		parent.setImage(fromVar<Image>(image));
-	});
-	
-	_imagePlacement.takeUntil(deallocated).subscribe([&parent](const var& imagePlacement) {
-		parent.setImagePlacement(fromVar<RectanglePlacement>(imagePlacement));
-	});
-}
+  image(makeObserver(coalesced([&parent](const var& image) {
+	  parent.setImage(fromVar<Image>(image));
+  }))),
+  imagePlacement(makeObserver(coalesced([&parent](const var& imagePlacement) {
+	  parent.setImagePlacement(fromVar<RectanglePlacement>(imagePlacement));
+  }))) {}
 
 LabelExtension::LabelExtension(Label& parent)
 : ComponentExtension(parent),
@@ -124,72 +439,89 @@ LabelExtension::LabelExtension(Label& parent)
   _textEditor(getTextEditor(parent)),
   text(parent.getText()),
   showEditor(parent.getCurrentTextEditor() != nullptr),
-  discardChangesWhenHidingEditor(_discardChangesWhenHidingEditor),
-  font(_font),
-  justificationType(_justificationType),
-  borderSize(_borderSize),
-  attachedComponent(_attachedComponent),
-  attachedOnLeft(_attachedOnLeft),
-  minimumHorizontalScale(_minimumHorizontalScale),
-  keyboardType(_keyboardType),
-  editableOnSingleClick(_editableOnSingleClick),
-  editableOnDoubleClick(_editableOnDoubleClick),
-  lossOfFocusDiscardsChanges(_lossOfFocusDiscardsChanges),
-  textEditor(_textEditor.distinctUntilChanged())
+  discardChangesWhenHidingEditor(makeObserver(coalesced([this](bool discard) {
+	  _discardChangesWhenHidingEditor = discard;
+  }))),
+  font(makeObserver(coalesced([&parent](var font) {
+	  parent.setFont(fromVar<Font>(font));
+  }))),
+  justificationType(makeObserver(coalesced([&parent](var justificationType) {
+	  parent.setJustificationType(fromVar<Justification>(justificationType));
+  }))),
+  borderSize(makeObserver(coalesced([&parent](var borderSize) {
+	  parent.setBorderSize(fromVar<BorderSize<int>>(borderSize));
+  }))),
+  attachedComponent(makeObserver(coalesced([&parent](var component) {
+	  parent.attachToComponent(fromVar<WeakReference<Component>>(component), parent.isAttachedOnLeft());
+  }))),
+  attachedOnLeft(makeObserver(coalesced([&parent](bool attachedOnLeft) {
+	  parent.attachToComponent(parent.getAttachedComponent(), attachedOnLeft);
+  }))),
+  minimumHorizontalScale(makeObserver(coalesced(std::bind(&Label::setMinimumHorizontalScale, &parent, _1)))),
+  keyboardType(makeObserver(coalesced([&parent](var v) {
+	  const auto keyboardType = fromVar<TextInputTarget::VirtualKeyboardType>(v);
+	  parent.setKeyboardType(keyboardType);
+	  
+	  if (auto editor = parent.getCurrentTextEditor()) {
+		  editor->setKeyboardType(keyboardType);
+	  }
+  }))),
+  editableOnSingleClick(makeObserver(coalesced([&parent](bool editable) {
+	  parent.setEditable(editable, parent.isEditableOnDoubleClick(), parent.doesLossOfFocusDiscardChanges());
+  }))),
+  editableOnDoubleClick(makeObserver(coalesced([&parent](bool editable) {
+	  parent.setEditable(parent.isEditableOnSingleClick(), editable, parent.doesLossOfFocusDiscardChanges());
+  }))),
+  lossOfFocusDiscardsChanges(makeObserver(coalesced([&parent](bool lossOfFocusDiscardsChanges) {
+	  parent.setEditable(parent.isEditableOnSingleClick(), parent.isEditableOnDoubleClick(), lossOfFocusDiscardsChanges);
+  }))),
+  textEditor(_textEditor.distinctUntilChanged()),
+  textEditorListener(_textEditor),
+  textEditorListenerRegistration([this, &parent]() {
+	  parent.addListener(&textEditorListener);
+	  
+	  // The editor may have changed while the listener wasn't registered
+	  _textEditor.onNext(getTextEditor(parent));
+  }, [this, &parent]() {
+	  parent.removeListener(&textEditorListener);
+  })
 {
 	parent.addListener(this);
 	
-	text.takeUntil(deallocated).subscribe(std::bind(&Label::setText, &parent, _1, sendNotificationSync));
+	text.subscribe(coalesced(std::bind(&Label::setText, &parent, _1, sendNotificationSync), [&parent]() {
+		return var(parent.getText());
+	})).disposedBy(disposeBag);
 	
-	showEditor.withLatestFrom(_discardChangesWhenHidingEditor).takeUntil(deallocated).subscribe([&parent](var items) {
-		if (items[0])
+	showEditor.subscribe(coalesced([this, &parent](bool show) {
+		if (show)
 			parent.showEditor();
 		else
-			parent.hideEditor(items[1]);
-	});
-	
-	_font.takeUntil(deallocated).subscribe([&parent](var font) {
-		parent.setFont(fromVar<Font>(font));
-	});
-	
-	_justificationType.takeUntil(deallocated).subscribe([&parent](var justificationType) {
-		parent.setJustificationType(fromVar<Justification>(justificationType));
-	});
-	
-	_borderSize.takeUntil(deallocated).subscribe([&parent](var borderSize) {
-		parent.setBorderSize(fromVar<BorderSize<int>>(borderSize));
-	});
-	
-	_attachedComponent.takeUntil(deallocated).subscribe([&parent](var component) {
-		parent.attachToComponent(fromVar<WeakReference<Component>>(component), parent.isAttachedOnLeft());
-	});
-	
-	_attachedOnLeft.takeUntil(deallocated).subscribe([&parent](bool attachedOnLeft) {
-		parent.attachToComponent(parent.getAttachedComponent(), attachedOnLeft);
-	});
-	
-	_minimumHorizontalScale.takeUntil(deallocated).subscribe(std::bind(&Label::setMinimumHorizontalScale, &parent, _1));
-	
-	_keyboardType.takeUntil(deallocated).subscribe([&parent](var v) {
-		const auto keyboardType = fromVar<TextInputTarget::VirtualKeyboardType>(v);
-		parent.setKeyboardType(keyboardType);
-		
-		if (auto editor = parent.getCurrentTextEditor()) {
-			editor->setKeyboardType(keyboardType);
-		}
-	});
-	
-	_editableOnSingleClick.takeUntil(deallocated).subscribe([&parent](bool editable) {
-		parent.setEditable(editable, parent.isEditableOnDoubleClick(), parent.doesLossOfFocusDiscardChanges());
-	});
-	
-	_editableOnDoubleClick.takeUntil(deallocated).subscribe([&parent](bool editable) {
-		parent.setEditable(parent.isEditableOnSingleClick(), editable, parent.doesLossOfFocusDiscardChanges());
-	});
+			parent.hideEditor(_discardChangesWhenHidingEditor);
+	}, [&parent]() {
+		return var(parent.getCurrentTextEditor() != nullptr);
+	})).disposedBy(disposeBag);
 	
-	_lossOfFocusDiscardsChanges.takeUntil(deallocated).subscribe([&parent](bool lossOfFocusDiscardsChanges) {
-		parent.setEditable(parent.isEditableOnSingleClick(), parent.isEditableOnDoubleClick(), lossOfFocusDiscardsChanges);
-	});
+	textEditorListenerRegistration.observe(_textEditor);
+}
+
+LabelExtension::~LabelExtension()
+{
+	static_cast<Label&>(parent).removeListener(this);
+}
+
+LabelExtension::TextEditorListener::TextEditorListener(const BehaviorSubject& textEditor)
+: textEditor(textEditor) {}
+
+void LabelExtension::TextEditorListener::labelTextChanged(Label *) {}
+
+void LabelExtension::TextEditorListener::editorShown(Label *parent, TextEditor&)
+{
+	textEditor.onNext(getTextEditor(*parent));
+}
+
+void LabelExtension::TextEditorListener::editorHidden(Label *parent, TextEditor&)
+{
+	textEditor.onNext(getTextEditor(*parent));
 }
 
 void LabelExtension::labelTextChanged(Label *parent)
@@ -199,22 +531,18 @@ void LabelExtension::labelTextChanged(Label *parent)
 	}
 }
 
-void LabelExtension::editorShown(Label *parent, TextEditor&)
+void LabelExtension::editorShown(Label *, TextEditor&)
 {
 	if (!showEditor.getLatestItem()) {
 		showEditor.onNext(true);
 	}
-	
-	_textEditor.onNext(getTextEditor(*parent));
 }
 
-void LabelExtension::editorHidden(Label *parent, TextEditor&)
+void LabelExtension::editorHidden(Label *, TextEditor&)
 {
 	if (showEditor.getLatestItem()) {
 		showEditor.onNext(false);
 	}
-	
-	_textEditor.onNext(getTextEditor(*parent));
 }
 
 var LabelExtension::getTextEditor(Label& label)
@@ -231,61 +559,86 @@ SliderExtension::SliderExtension(Slider& parent, Observer getValueFromText, Obse
   _dragging(false),
   _discardChangesWhenHidingTextBox(false),
   value(parent.getValue()),
-  minimum(_minimum),
-  maximum(_maximum),
+  minimum(makeObserver(coalesced([&parent](double minimum) {
+	  parent.setRange(minimum, parent.getMaximum(), parent.getInterval());
+  }))),
+  maximum(makeObserver(coalesced([&parent](double maximum) {
+	  parent.setRange(parent.getMinimum(), maximum, parent.getInterval());
+  }))),
   minValue(hasMultipleThumbs(parent) ? parent.getMinValue() : parent.getValue()),
   maxValue(hasMultipleThumbs(parent) ? parent.getMaxValue() : parent.getValue()),
-  doubleClickReturnValue(_doubleClickReturnValue),
-  interval(_interval),
-  skewFactorMidPoint(_skewFactorMidPoint),
+  doubleClickReturnValue(makeObserver(coalesced([&parent](var value) {
+	  parent.setDoubleClickReturnValue(!value.isUndefined(), value);
+  }))),
+  interval(makeObserver(coalesced([&parent](double interval) {
+	  parent.setRange(parent.getMinimum(), parent.getMaximum(), interval);
+  }))),
+  skewFactorMidPoint(makeObserver(coalesced(std::bind(&Slider::setSkewFactorFromMidPoint, &parent, _1)))),
   dragging(_dragging.distinctUntilChanged()),
   thumbBeingDragged(dragging.map([&parent](bool dragging) { return (dragging ? var(parent.getThumbBeingDragged()) : var::undefined()); })),
-  showTextBox(_showTextBox),
-  textBoxIsEditable(_textBoxIsEditable),
-  discardChangesWhenHidingTextBox(_discardChangesWhenHidingTextBox),
+  showTextBox(makeObserver(coalesced([this, &parent](bool show) {
+	  if (show)
+		  parent.showTextBox();
+	  else
+		  parent.hideTextBox(_discardChangesWhenHidingTextBox);
+  }))),
+  textBoxIsEditable(makeObserver(coalesced(std::bind(&Slider::setTextBoxIsEditable, &parent, _1)))),
+  discardChangesWhenHidingTextBox(makeObserver(coalesced([this](bool discard) {
+	  _discardChangesWhenHidingTextBox = discard;
+  }))),
   getValueFromText(getValueFromText),
-  getTextFromValue(getTextFromValue)
+  getTextFromValue(getTextFromValue),
+  dragListener(_dragging),
+  dragListenerRegistration([this, &parent]() {
+	  parent.addListener(&dragListener);
+	  
+	  // A drag may have started or ended while the listener wasn't registered
+	  _dragging.onNext(parent.getThumbBeingDragged() >= 0);
+  }, [this, &parent]() {
+	  parent.removeListener(&dragListener);
+  })
 {
 	parent.addListener(this);
 	
-	value.takeUntil(deallocated).subscribe([&parent](double value) {
+	value.subscribe(coalesced([&parent](double value) {
 		parent.setValue(value, sendNotificationSync);
-	});
+	}, [&parent]() {
+		return var(parent.getValue());
+	})).disposedBy(disposeBag);
 	
-	_minimum.takeUntil(deallocated).subscribe([&parent](double minimum) {
-		parent.setRange(minimum, parent.getMaximum(), parent.getInterval());
-	});
-	
-	_maximum.takeUntil(deallocated).subscribe([&parent](double maximum) {
-		parent.setRange(parent.getMinimum(), maximum, parent.getInterval());
-	});
-	
-	minValue.skip(1).takeUntil(deallocated).subscribe([&parent](double minValue) {
+	minValue.skip(1).subscribe(coalesced([&parent](double minValue) {
 		parent.setMinValue(minValue, sendNotificationSync, true);
-	});
+	}, [&parent]() {
+		return (hasMultipleThumbs(parent) ? var(parent.getMinValue()) : var::undefined());
+	})).disposedBy(disposeBag);
 	
-	maxValue.skip(1).takeUntil(deallocated).subscribe([&parent](double maxValue) {
+	maxValue.skip(1).subscribe(coalesced([&parent](double maxValue) {
 		parent.setMaxValue(maxValue, sendNotificationSync, true);
-	});
-	
-	_doubleClickReturnValue.takeUntil(deallocated).subscribe([&parent](var value) {
-		parent.setDoubleClickReturnValue(!value.isUndefined(), value);
-	});
+	}, [&parent]() {
+		return (hasMultipleThumbs(parent) ? var(parent.getMaxValue()) : var::undefined());
+	})).disposedBy(disposeBag);
 	
-	_interval.takeUntil(deallocated).subscribe([&parent](double interval) {
-		parent.setRange(parent.getMinimum(), parent.getMaximum(), interval);
-	});
-	
-	_skewFactorMidPoint.takeUntil(deallocated).subscribe(std::bind(&Slider::setSkewFactorFromMidPoint, &parent, _1));
-	
-	_showTextBox.withLatestFrom(_discardChangesWhenHidingTextBox).takeUntil(deallocated).subscribe([&parent](var items) {
-		if (items[0])
-			parent.showTextBox();
-		else
-			parent.hideTextBox(items[1]);
-	});
-	
-	_textBoxIsEditable.takeUntil(deallocated).subscribe(std::bind(&Slider::setTextBoxIsEditable, &parent, _1));
+	dragListenerRegistration.observe(_dragging);
+}
+
+SliderExtension::~SliderExtension()
+{
+	static_cast<Slider&>(parent).removeListener(this);
+}
+
+SliderExtension::DragListener::DragListener(const BehaviorSubject& dragging)
+: dragging(dragging) {}
+
+void SliderExtension::DragListener::sliderValueChanged(Slider *) {}
+
+void SliderExtension::DragListener::sliderDragStarted(Slider *)
+{
+	dragging.onNext(true);
+}
+
+void SliderExtension::DragListener::sliderDragEnded(Slider *)
+{
+	dragging.onNext(false);
 }
 
 void SliderExtension::sliderValueChanged(Slider *slider)
@@ -302,16 +655,6 @@ void SliderExtension::sliderValueChanged(Slider *slider)
 	}
 }
 
-void SliderExtension::sliderDragStarted(Slider *)
-{
-	_dragging.onNext(true);
-}
-
-void SliderExtension::sliderDragEnded(Slider *)
-{
-	_dragging.onNext(false);
-}
-
 bool SliderExtension::hasMultipleThumbs(const juce::Slider& parent)
 {
 	switch (parent.getSliderStyle()) {
@@ -30,14 +30,76 @@ public:
 	 */
 	const Observable deallocated;
 	
+	/**
+		Controls whether items that are pushed to the properties of the extension are applied to the component immediately (the default), or once per tick of the TickClock (60 Hz, not synchronised with the display).
+	 
+		If enabled, each property just remembers its latest item, and the latest items of all properties are applied together with the next tick. So if the component gets many items within a tick, each JUCE setter is only called once, and the component is laid out and repainted only once.
+	 
+		The latest item of a BehaviorSubject property (e.g. LabelExtension::text) is updated immediately, only the component is updated later. Disabling it applies the pending items immediately.
+	 */
+	void setCoalescesUpdatesPerFrame(bool shouldCoalesce);
+	
 protected:
 	ExtensionBase();
+	
+	/**
+		Returns a function that calls `setter` immediately, or remembers the item for the next frame if the extension coalesces updates. Use this for the subscriptions that update the component.
+	 
+		If the property is also updated from a JUCE listener, pass a function that returns the component's current state. An item that equals the current state isn't remembered, and it discards a remembered item for the property. Otherwise, an item that came from the listener would be applied again on the next frame, and overwrite changes that have been made without notification in between.
+	 */
+	std::function<void(const juce::var&)> coalesced(const std::function<void(const juce::var&)>& setter, const std::function<juce::var()>& getCurrentItem = nullptr) const;
+	
+	/**
+		Returns an Observer that calls `onNext` for each item. It doesn't need a Subject or a subscription, so it doesn't add anything to the disposeBag.
+	 
+		onCompleted ends just this Observer. onError terminates the app, like Observable::subscribe without an onError handler. `onNext` must not access the extension after it's destroyed (e.g. by using a function returned from coalesced).
+	 */
+	static Observer makeObserver(const std::function<void(const juce::var&)>& onNext);
+	
+	/**
+		Disposes the subscriptions of the extension when it's destroyed.
+	 
+		Subclasses should add their subscriptions here, instead of using takeUntil(deallocated) for each of them. It's mutable, so that subscriptions can be added from const member functions.
+	 */
+	mutable DisposeBag disposeBag;
+	
+	/**
+		Registers a JUCE listener only while the extension is observed, i.e. while at least one of the observed Subjects has a subscriber. The subscriptions that the extension makes itself aren't counted.
+	 
+		While the listener isn't registered, the Subjects miss changes of the component. So use this only for event streams (e.g. ButtonExtension::clicked). A listener that keeps the latest item of a BehaviorSubject up to date must always be registered. The function that adds the listener may update the Subjects from the component.
+	 
+		The listener is always added and removed on the message thread, because JUCE's listener lists aren't thread-safe. If a subscription is made on another thread, the listener is added asynchronously, so events that happen before that are missed.
+	 */
+	class ListenerRegistration
+	{
+	public:
+		/** Creates an instance that calls `addListener` when the extension becomes observed, and `removeListener` when it's not observed anymore. */
+		ListenerRegistration(const std::function<void()>& addListener, const std::function<void()>& removeListener);
+		
+		/** Removes the listener, if it's registered. */
+		~ListenerRegistration();
+		
+		/** Observes the subscribers of a Subject. The subscriptions that the Subject has at this point are considered the extension's own, so call this after the extension has subscribed to the Subject. */
+		void observe(const Subject& subject);
+		
+	private:
+		struct State;
+		const std::shared_ptr<State> state;
+		
+		JUCE_DECLARE_NON_COPYABLE(ListenerRegistration)
+	};
+	
+private:
+	struct Staging;
+	const std::shared_ptr<Staging> staging;
 };
 
 /**
 	Connects a juce::Value with a BehaviorSubject.
  
 	Whenever the Value changes, the BehaviorSubject is changed, and vice versa.
+ 
+	By default, changes of the Value are propagated asynchronously. Use a SynchronousValueSource to propagate them immediately.
  */
 class ValueExtension : public ExtensionBase, private juce::Value::Listener
 {
@@ -54,21 +116,79 @@ private:
 	void valueChanged(juce::Value&) override;
 };
 
+/**
+	Connects a juce::ValueTree with Subjects for its properties, and Observables for its children.
+ 
+	The extension uses a single ValueTree::Listener, no matter how many properties are observed. A property change is routed to the subject of that property through a hash map, so observing thousands of properties doesn't add any listeners.
+ 
+	Changes are propagated synchronously. Changes in the children of the tree are not reported.
+ */
+class ValueTreeExtension : public ExtensionBase, private juce::ValueTree::Listener
+{
+	const PublishSubject _childAdded;
+	const PublishSubject _childRemoved;
+	
+public:
+	/** Creates a new instance with a given ValueTree. The connection refers to the **shared data** of `inputTree`. */
+	ValueTreeExtension(const juce::ValueTree& inputTree);
+	
+	/**
+		Returns the subject that's connected to the property with the given name. This changes whenever the property changes, and vice versa.
+	 
+		The initial item is the current value of the property, or void if the tree doesn't have this property. If the property is removed, the subject emits void, and pushing void removes the property. A change of the type (e.g. from 1 to "1") is emitted, too. Calling this again with the same name returns the same subject.
+	 */
+	BehaviorSubject property(const juce::Identifier& name) const;
+	
+	/** Emits the child whenever a child is added to the tree.​ **Type: ValueTree** */
+	const Observable childAdded;
+	
+	/** Emits the child whenever a child is removed from the tree.​ **Type: ValueTree** */
+	const Observable childRemoved;
+	
+private:
+	struct IdentifierHash
+	{
+		size_t operator()(const juce::Identifier& identifier) const;
+	};
+	
+	juce::ValueTree tree;
+	mutable juce::CriticalSection propertiesLock;
+	mutable std::unordered_map<juce::Identifier, BehaviorSubject, IdentifierHash> properties;
+	
+	void valueTreePropertyChanged(juce::ValueTree&, const juce::Identifier&) override;
+	void valueTreeChildAdded(juce::ValueTree&, juce::ValueTree&) override;
+	void valueTreeChildRemoved(juce::ValueTree&, juce::ValueTree&, int) override;
+	void valueTreeChildOrderChanged(juce::ValueTree&, int, int) override;
+	void valueTreeParentChanged(juce::ValueTree&) override;
+};
+
 /**
 	Adds reactive extensions to a juce::Component.
+ 
+	The listeners that keep BehaviorSubjects like visible up to date are always registered. The extension and its subclasses only listen for events (e.g. ButtonExtension::clicked) while the Observable for the events has a subscriber.
  */
 class ComponentExtension : public ExtensionBase, private juce::ComponentListener
 {
+protected:
+	/** The Component that's extended. Subclasses use it to remove their listeners when they're destroyed. */
 	juce::Component& parent;
-	std::function<void(const Subject&)> storeSubject;
+	
+private:
+	mutable juce::Array<int> colourIds;
+	mutable std::vector<std::function<void(const juce::var&)>> colourSetters;
+	mutable juce::CriticalSection colourLock;
+	
 public:
 	/** Creates a new instance for a given juce::Component */
 	ComponentExtension(juce::Component& parent);
 	
+	/** Removes the listener from the Component. */
+	~ComponentExtension();
+	
 	/** Controls the visibility of the Component, and emits an item whenever it changes.​ **Type: bool** */
 	const BehaviorSubject visible;
 	
-	/** Returns an Observer that controls the colour for the given colourId.​ **Type: Colour** */
+	/** Returns an Observer that controls the colour for the given colourId. Each call returns a new Observer, so completing one doesn't affect the others. The Observers for the same colourId share one setter, and they don't add subscriptions to the extension, so calling this repeatedly doesn't use more memory.​ **Type: Colour** */
 	Observer colour(int colourId) const;
 	
 private:
@@ -81,13 +201,14 @@ private:
 class ButtonExtension : public ComponentExtension, private juce::Button::Listener
 {
 	const PublishSubject _clicked;
-	const PublishSubject _text;
-	const PublishSubject _tooltip;
 	
 public:
 	/** Creates a new instance for a given Button. */
 	ButtonExtension(juce::Button& parent);
 	
+	/** Removes the listener from the Button. */
+	~ButtonExtension();
+	
 	/** Emits an item whenever the Button is clicked.​ **Type: undefined** */
 	const Observable clicked;
 	
@@ -104,6 +225,18 @@ public:
 	const Observer tooltip;
 	
 private:
+	/** Emits clicks. It's a separate listener, so that it's only registered while clicked has a subscriber. */
+	struct ClickListener : public juce::Button::Listener
+	{
+		explicit ClickListener(const PublishSubject& clicked);
+		void buttonClicked(juce::Button *) override;
+		
+		const PublishSubject clicked;
+	};
+	
+	ClickListener clickListener;
+	ListenerRegistration clickListenerRegistration;
+	
 	void buttonClicked(juce::Button *) override;
 	void buttonStateChanged(juce::Button *) override;
 };
@@ -113,9 +246,6 @@ private:
  */
 class ImageComponentExtension : public ComponentExtension
 {
-	const PublishSubject _image;
-	const PublishSubject _imagePlacement;
-	
 public:
 	/** Creates a new instance for a given ImageComponent. */
 	ImageComponentExtension(juce::ImageComponent& parent);
@@ -132,23 +262,16 @@ public:
  */
 class LabelExtension : public ComponentExtension, private juce::Label::Listener
 {
-	const BehaviorSubject _discardChangesWhenHidingEditor;
-	const PublishSubject _font;
-	const PublishSubject _justificationType;
-	const PublishSubject _borderSize;
-	const PublishSubject _attachedComponent;
-	const PublishSubject _attachedOnLeft;
-	const PublishSubject _minimumHorizontalScale;
-	const PublishSubject _keyboardType;
-	const PublishSubject _editableOnSingleClick;
-	const PublishSubject _editableOnDoubleClick;
-	const PublishSubject _lossOfFocusDiscardsChanges;
+	std::atomic<bool> _discardChangesWhenHidingEditor;
 	const BehaviorSubject _textEditor;
 	
 public:
 	/** Creates a new instance for a given Label. */
 	LabelExtension(juce::Label& parent);
 	
+	/** Removes the listener from the Label. */
+	~LabelExtension();
+	
 	/** Controls the Label's text. Setting a new string notifies all Label::Listeners.​ **Type: String** */
 	const BehaviorSubject text;
 	
@@ -192,6 +315,20 @@ public:
 	const Observable textEditor;
 	
 private:
+	/** Emits the current TextEditor. It's a separate listener, so that it's only registered while textEditor has a subscriber. */
+	struct TextEditorListener : public juce::Label::Listener
+	{
+		explicit TextEditorListener(const BehaviorSubject& textEditor);
+		void labelTextChanged(juce::Label *) override;
+		void editorShown(juce::Label *, juce::TextEditor&) override;
+		void editorHidden(juce::Label *, juce::TextEditor&) override;
+		
+		const BehaviorSubject textEditor;
+	};
+	
+	TextEditorListener textEditorListener;
+	ListenerRegistration textEditorListenerRegistration;
+	
 	void labelTextChanged(juce::Label *) override;
 	void editorShown(juce::Label *, juce::TextEditor&) override;
 	void editorHidden(juce::Label *, juce::TextEditor&) override;
@@ -206,20 +343,16 @@ private:
  */
 class SliderExtension : public ComponentExtension, private juce::Slider::Listener
 {
-	PublishSubject _minimum;
-	PublishSubject _maximum;
-	PublishSubject _doubleClickReturnValue;
-	PublishSubject _interval;
-	PublishSubject _skewFactorMidPoint;
 	BehaviorSubject _dragging;
-	BehaviorSubject _discardChangesWhenHidingTextBox;
-	PublishSubject _showTextBox;
-	PublishSubject _textBoxIsEditable;
+	std::atomic<bool> _discardChangesWhenHidingTextBox;
 	
 public:
 	/** Creates a new instance for a given Slider. */
 	SliderExtension(juce::Slider& parent, Observer getValueFromText, Observer getTextFromValue);
 	
+	/** Removes the listener from the Slider. */
+	~SliderExtension();
+	
 	/** Controls the Slider value.​ **Type: double** */
 	const BehaviorSubject value;
 	
@@ -266,9 +399,21 @@ public:
 	const Observer getTextFromValue;
 	
 private:
+	/** Emits whether the Slider is being dragged. It's a separate listener, so that it's only registered while dragging has a subscriber. */
+	struct DragListener : public juce::Slider::Listener
+	{
+		explicit DragListener(const BehaviorSubject& dragging);
+		void sliderValueChanged(juce::Slider *) override;
+		void sliderDragStarted(juce::Slider *) override;
+		void sliderDragEnded(juce::Slider *) override;
+		
+		const BehaviorSubject dragging;
+	};
+	
+	DragListener dragListener;
+	ListenerRegistration dragListenerRegistration;
+	
 	void sliderValueChanged(juce::Slider *slider) override;
-	void sliderDragStarted(juce::Slider *) override;
-	void sliderDragEnded(juce::Slider *) override;
 	
 	static bool hasMultipleThumbs(const juce::Slider& parent);
 };
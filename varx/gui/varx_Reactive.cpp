@@ -26,3 +26,15 @@ Reactive<Value>& Reactive<Value>::operator=(const var& newValue)
 }
 
 
+Reactive<ValueTree>::Reactive()
+: rx(*this) {}
+
+Reactive<ValueTree>::Reactive(const ValueTree& other)
+: ValueTree(other),
+  rx(*this) {}
+
+Reactive<ValueTree>::Reactive(const Identifier& type)
+: ValueTree(type),
+  rx(*this) {}
+
+
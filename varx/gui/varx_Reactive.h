@@ -71,6 +71,38 @@ private:
 	Reactive& operator=(const Reactive&) = delete;
 };
 
+/**
+	Adds reactive extensions to a juce::ValueTree.
+ 
+	Instead of creating a juce::ValueTree, create an instance of this as follows:
+ 
+		Reactive<ValueTree> myTree(someTree);
+ 
+	It inherits from juce::ValueTree, so you can use it as a drop-in replacement. And you can subscribe to a property, or to the children that are added and removed:
+ 
+		myTree.rx.property("name").subscribe(...);
+		myTree.rx.childAdded.subscribe(...);
+ 
+	The extension refers to the shared data of the tree that was passed to the constructor.
+ */
+template<>
+class Reactive<juce::ValueTree> : public juce::ValueTree
+{
+public:
+	/** Creates a new instance. Has the same behavior as the juce::ValueTree equivalent. */
+	///@{
+	Reactive();
+	Reactive(const ValueTree& other);
+	explicit Reactive(const juce::Identifier& type);
+	///@}
+	
+	/** The reactive extension object. */
+	const ValueTreeExtension rx;
+	
+private:
+	Reactive& operator=(const Reactive&) = delete;
+};
+
 /**
 	Adds reactive extensions to a juce::Component (or subclass).
  */
@@ -153,6 +185,7 @@ class Reactive<Slider, detail::IsSlider<Slider>> : public Slider
 	
 	PublishSubject getValueFromText_Subject;
 	PublishSubject getTextFromValue_Subject;
+	DisposeBag disposeBag;
 public:
 	/** Creates a new instance. @see juce::Slider::Slider. */
 	template<typename... Args>
@@ -160,14 +193,14 @@ public:
 	: Slider(std::forward<Args>(args)...),
 	  rx(*this, getValueFromText_Subject.asObserver(), getTextFromValue_Subject.asObserver())
 	{
-		getValueFromText_Subject.takeUntil(rx.deallocated).subscribe([this](juce::var function) {
+		getValueFromText_Subject.subscribe([this](juce::var function) {
 			this->getValueFromText_Function = fromVar<GetValueFromText_Function>(function);
-		});
+		}).disposedBy(disposeBag);
 		
-		getTextFromValue_Subject.takeUntil(rx.deallocated).subscribe([this](juce::var function) {
+		getTextFromValue_Subject.subscribe([this](juce::var function) {
 			this->getTextFromValue_Function = fromVar<GetTextFromValue_Function>(function);
 			this->updateText();
-		});
+		}).disposedBy(disposeBag);
 	}
 	
 	/** The reactive extension object. */
@@ -0,0 +1,458 @@
+/*
+  ==============================================================================
+    
+    varx_Derived_Impl.cpp
+    Created: 19 Oct 2026 7:22:41pm
+    Author:  Martin Finke
+  
+  ==============================================================================
+*/
+
+#include "varx_Derived_Impl.h"
+
+Derived::Impl::GraphLock::GraphLock(const Impl& node)
+{
+	// The graph may be merged while waiting for its lock
+	for (;;) {
+		graph = node.getGraph();
+		graph->lock.enter();
+		
+		if (std::atomic_load(&graph->mergedInto) == nullptr)
+			return;
+		
+		graph->lock.exit();
+	}
+}
+
+Derived::Impl::GraphLock::~GraphLock()
+{
+	graph->lock.exit();
+}
+
+Derived::Impl::Impl(const std::shared_ptr<Graph>& graph)
+: rank(0),
+  subscribers(std::make_shared<SubscriberList>()),
+  queue(nullptr),
+  isLazy(false),
+  isDirty(false),
+  isComputing(false),
+  graph(graph) {}
+
+Derived::Impl::~Impl()
+{
+	sourceSubscription.unsubscribe();
+	
+	if (subject != nullptr) {
+		const ScopedLock sl(getSourcesLock());
+		auto& sources = getSources();
+		auto it = sources.find(subject.get());
+		
+		// There may already be a new source for the same subject
+		if (it != sources.end() && it->second.expired())
+			sources.erase(it);
+	}
+}
+
+std::shared_ptr<Derived::Impl> Derived::Impl::forSubject(const std::shared_ptr<const void>& subject, const rxcpp::observable<var>& observable, const var& latestItem)
+{
+	std::shared_ptr<Impl> source;
+	
+	{
+		const ScopedLock sl(getSourcesLock());
+		auto& sources = getSources();
+		auto it = sources.find(subject.get());
+		
+		if (it != sources.end()) {
+			if (auto existing = it->second.lock())
+				return existing;
+		}
+		
+		source = std::shared_ptr<Impl>(new Impl(std::make_shared<Graph>()));
+		source->subject = subject;
+		source->value = latestItem;
+		sources[subject.get()] = source;
+	}
+	
+	// Subscribe outside of the lock, because the subject emits synchronously
+	std::weak_ptr<Impl> weakSource = source;
+	source->sourceSubscription = observable.subscribe([weakSource](const var& next) {
+		if (auto strongSource = weakSource.lock())
+			strongSource->sourceChanged(next);
+	});
+	
+	return source;
+}
+
+std::shared_ptr<Derived::Impl> Derived::Impl::create(const std::vector<std::shared_ptr<Impl>>& inputs, const Compute& compute)
+{
+	// The inputs are connected through the new node, so they must be in the same graph
+	for (size_t i = 1; i < inputs.size(); ++i)
+		merge(inputs[0]->getGraph(), inputs[i]->getGraph());
+	
+	auto node = std::shared_ptr<Impl>(new Impl(inputs.empty() ? std::make_shared<Graph>() : inputs[0]->getGraph()));
+	node->compute = compute;
+	
+	for (;;) {
+		try {
+			const GraphLock lock(*node);
+			node->setInputs(inputs);
+			node->value = compute();
+			return node;
+		}
+		catch (const MergeNeeded& mergeNeeded) {
+			merge(mergeNeeded.first, mergeNeeded.second);
+		}
+	}
+}
+
+std::shared_ptr<Derived::Impl> Derived::Impl::createLazy(const LazyCompute& compute)
+{
+	auto node = std::shared_ptr<Impl>(new Impl(std::make_shared<Graph>()));
+	node->lazyCompute = compute;
+	node->isLazy = true;
+	node->isDirty = true;
+	
+	return node;
+}
+
+var Derived::Impl::read(Impl& reader, const std::shared_ptr<Impl>& input, std::vector<std::shared_ptr<Impl>>& dependencies)
+{
+	// The reader's lock is held. Blocking on the input's lock could deadlock, so abort if it isn't free.
+	const std::shared_ptr<Graph> readerGraph = reader.getGraph();
+	const std::shared_ptr<Graph> inputGraph = input->getGraph();
+	
+	if (inputGraph != readerGraph && !tryMerge(readerGraph, inputGraph))
+		throw MergeNeeded{readerGraph, inputGraph};
+	
+	if (std::find(dependencies.begin(), dependencies.end(), input) == dependencies.end())
+		dependencies.push_back(input);
+	
+	return input->refreshedValue();
+}
+
+var Derived::Impl::getValue()
+{
+	for (;;) {
+		try {
+			const GraphLock lock(*this);
+			return refreshedValue();
+		}
+		catch (const MergeNeeded& mergeNeeded) {
+			merge(mergeNeeded.first, mergeNeeded.second);
+		}
+	}
+}
+
+const var& Derived::Impl::refreshedValue()
+{
+	if (isDirty)
+		value = recompute();
+	
+	return value;
+}
+
+rxcpp::observable<var> Derived::Impl::asObservable()
+{
+	const std::shared_ptr<Impl> node = shared_from_this();
+	
+	return rxcpp::observable<>::create<var>([node](rxcpp::subscriber<var> s) {
+		for (;;) {
+			try {
+				// Under the lock, so that no change can happen in between
+				const GraphLock lock(*node);
+				const var initialValue = node->refreshedValue();
+				s.on_next(initialValue);
+				node->subscribers->add(s);
+				return;
+			}
+			catch (const MergeNeeded& mergeNeeded) {
+				merge(mergeNeeded.first, mergeNeeded.second);
+			}
+		}
+	});
+}
+
+CriticalSection& Derived::Impl::getSourcesLock()
+{
+	static CriticalSection lock;
+	return lock;
+}
+
+std::map<const void*, std::weak_ptr<Derived::Impl>>& Derived::Impl::getSources()
+{
+	static std::map<const void*, std::weak_ptr<Impl>> sources;
+	return sources;
+}
+
+std::shared_ptr<Derived::Impl::Graph> Derived::Impl::getGraph() const
+{
+	std::shared_ptr<Graph> current = graph;
+	
+	while (auto next = std::atomic_load(&current->mergedInto))
+		current = next;
+	
+	return current;
+}
+
+void Derived::Impl::merge(std::shared_ptr<Graph> first, std::shared_ptr<Graph> second)
+{
+	// Must be called without holding a graph lock. The locks are taken in the order of their addresses, so concurrent merges can't deadlock.
+	for (;;) {
+		while (auto next = std::atomic_load(&first->mergedInto))
+			first = next;
+		while (auto next = std::atomic_load(&second->mergedInto))
+			second = next;
+		
+		if (first == second)
+			return;
+		
+		if (second.get() < first.get())
+			std::swap(first, second);
+		
+		const ScopedLock firstLock(first->lock);
+		const ScopedLock secondLock(second->lock);
+		
+		// One of them may have been merged while waiting
+		if (std::atomic_load(&first->mergedInto) != nullptr || std::atomic_load(&second->mergedInto) != nullptr)
+			continue;
+		
+		std::atomic_store(&second->mergedInto, first);
+		return;
+	}
+}
+
+bool Derived::Impl::tryMerge(const std::shared_ptr<Graph>& lockedGraph, const std::shared_ptr<Graph>& otherGraph)
+{
+	if (!otherGraph->lock.tryEnter())
+		return false;
+	
+	// The other graph may have been merged in the meantime
+	const bool canMerge = (std::atomic_load(&otherGraph->mergedInto) == nullptr);
+	if (canMerge)
+		std::atomic_store(&otherGraph->mergedInto, lockedGraph);
+	
+	otherGraph->lock.exit();
+	return canMerge;
+}
+
+void Derived::Impl::setInputs(const std::vector<std::shared_ptr<Impl>>& newInputs)
+{
+	const std::shared_ptr<Impl> self = shared_from_this();
+	
+	for (auto& input : inputs) {
+		auto& c = input->children;
+		c.erase(std::remove_if(c.begin(), c.end(), [this](const std::weak_ptr<Impl>& child) {
+			auto strongChild = child.lock();
+			return (strongChild == nullptr || strongChild.get() == this);
+		}), c.end());
+	}
+	
+	inputs = newInputs;
+	
+	for (auto& input : inputs)
+		input->children.push_back(self);
+	
+	updateRank();
+}
+
+void Derived::Impl::updateRank()
+{
+	int newRank = 0;
+	for (auto& input : inputs)
+		newRank = jmax(newRank, input->rank + 1);
+	
+	if (newRank == rank)
+		return;
+	
+	// Keep the propagation queue ordered by rank
+	if (queue != nullptr) {
+		const std::shared_ptr<Impl> self = shared_from_this();
+		queue->erase(std::make_pair(rank, self));
+		queue->insert(std::make_pair(newRank, self));
+	}
+	
+	rank = newRank;
+	
+	// The children must stay ranked above this node
+	for (auto& child : children) {
+		if (auto strongChild = child.lock())
+			strongChild->updateRank();
+	}
+}
+
+bool Derived::Impl::isObserved() const
+{
+	if (!subscribers->isEmpty())
+		return true;
+	
+	for (auto& child : children) {
+		auto strongChild = child.lock();
+		if (strongChild != nullptr && (!strongChild->isLazy || strongChild->isObserved()))
+			return true;
+	}
+	
+	return false;
+}
+
+void Derived::Impl::invalidate()
+{
+	// If this node is already dirty, its children are dirty, too
+	if (isDirty)
+		return;
+	
+	isDirty = true;
+	
+	for (auto& child : children) {
+		if (auto strongChild = child.lock())
+			strongChild->invalidate();
+	}
+}
+
+var Derived::Impl::recompute()
+{
+	if (!isLazy) {
+		const var newValue = compute();
+		isDirty = false;
+		return newValue;
+	}
+	
+	// A Computed value can't depend on itself
+	jassert(!isComputing);
+	if (isComputing)
+		return value;
+	
+	Computed::Reader reader(*this);
+	var newValue;
+	
+	{
+		const ScopedValueSetter<bool> computing(isComputing, true);
+		newValue = lazyCompute(reader);
+	}
+	
+	setInputs(reader.dependencies);
+	isDirty = false;
+	
+	return newValue;
+}
+
+void Derived::Impl::sourceChanged(const var& newValue)
+{
+	Emissions emissions;
+	Deferred deferred;
+	
+	{
+		const GraphLock lock(*this);
+		if (newValue.equalsWithSameType(value))
+			return;
+		
+		value = newValue;
+		propagate(emissions, deferred);
+	}
+	
+	// Nodes that have read a node of another graph are recomputed after merging the graphs
+	while (!deferred.empty()) {
+		const auto entry = deferred.back();
+		deferred.pop_back();
+		
+		merge(entry.second.first, entry.second.second);
+		entry.first->refresh(emissions, deferred);
+	}
+	
+	for (auto& emission : emissions)
+		emission.first->subscribers->onNext(emission.second);
+}
+
+void Derived::Impl::refresh(Emissions& emissions, Deferred& deferred)
+{
+	const GraphLock lock(*this);
+	
+	// Nobody needs the new value of an unobserved lazy node yet
+	if (isLazy && !isObserved()) {
+		invalidate();
+		return;
+	}
+	
+	var newValue;
+	
+	try {
+		newValue = recompute();
+	}
+	catch (const MergeNeeded& mergeNeeded) {
+		deferred.push_back(std::make_pair(shared_from_this(), mergeNeeded));
+		return;
+	}
+	
+	if (newValue.equalsWithSameType(value))
+		return;
+	
+	value = newValue;
+	emissions.push_back(std::make_pair(shared_from_this(), newValue));
+	propagate(emissions, deferred);
+}
+
+void Derived::Impl::propagate(Emissions& emissions, Deferred& deferred)
+{
+	Queue queue;
+	
+	const auto enqueue = [&queue](const std::shared_ptr<Impl>& node) {
+		if (node->queue == nullptr) {
+			node->queue = &queue;
+			queue.insert(std::make_pair(node->rank, node));
+		}
+	};
+	
+	const auto enqueueChildren = [&enqueue](Impl& node) {
+		for (auto& child : node.children) {
+			if (auto strongChild = child.lock())
+				enqueue(strongChild);
+		}
+	};
+	
+	try {
+		enqueueChildren(*this);
+		
+		while (!queue.empty()) {
+			const std::shared_ptr<Impl> node = queue.begin()->second;
+			queue.erase(queue.begin());
+			node->queue = nullptr;
+			
+			// Nobody needs the new value of an unobserved lazy node yet
+			if (node->isLazy && !node->isObserved()) {
+				node->invalidate();
+				continue;
+			}
+			
+			const int previousRank = node->rank;
+			var newValue;
+			
+			try {
+				newValue = node->recompute();
+			}
+			catch (const MergeNeeded& mergeNeeded) {
+				// It keeps its previous value until it's recomputed after merging the graphs. Its children may see that value once.
+				deferred.push_back(std::make_pair(node, mergeNeeded));
+				continue;
+			}
+			
+			// The node has read an input that may not be up to date yet. Recompute it after all nodes below its new rank.
+			if (node->rank > previousRank) {
+				enqueue(node);
+				continue;
+			}
+			
+			if (newValue.equalsWithSameType(node->value))
+				continue;
+			
+			node->value = newValue;
+			emissions.push_back(std::make_pair(node, newValue));
+			enqueueChildren(*node);
+		}
+	}
+	catch (...) {
+		// The queue is going away, so the nodes mustn't point to it anymore
+		for (auto& entry : queue)
+			entry.second->queue = nullptr;
+		
+		throw;
+	}
+}
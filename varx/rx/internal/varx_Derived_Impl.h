@@ -0,0 +1,125 @@
+/*
+  ==============================================================================
+    
+    varx_Derived_Impl.h
+    Created: 19 Oct 2026 7:22:41pm
+    Author:  Martin Finke
+  
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "varx_Subjects_Impl.h"
+
+/**
+	A node in the propagation graph. It's either a source (wrapping a BehaviorSubject), or it computes its value from its inputs.
+ 
+	The rank of a node is greater than the ranks of all its inputs. When a source changes, the affected nodes are recomputed in the order of their rank, so each node is recomputed after all its inputs are up to date.
+ 
+	The ranks can change while propagating, because a lazy node may read different inputs each time. So the queue is an ordered set, and a queued node is re-inserted when its rank changes. If a lazy node starts to read an input with the same or a higher rank, that input may not be up to date yet: The node is queued again at its new rank, and its value is only emitted after the second recompute.
+ 
+	A lazy node (for a Computed value) tracks its inputs while it computes. If it's not observed when an input changes, it's just marked dirty (together with its children), and recomputed when it's read next time.
+ 
+	Each connected graph of nodes has its own lock, so independent graphs don't block each other. When nodes get connected, their graphs are merged: The merged graph forwards to the other one, and both locks are taken in a fixed order. A lazy node may read a node of another graph while its own lock is held. Waiting for the other lock could deadlock then, so the graphs are only merged if the other lock is free. Otherwise, the computation is aborted, the graphs are merged after releasing the lock, and the node is recomputed.
+ 
+	Emissions happen after propagating, outside of the lock.
+ */
+struct Derived::Impl : public std::enable_shared_from_this<Derived::Impl>
+{
+public:
+	typedef std::function<var()> Compute;
+	typedef std::function<var(const Computed::Reader&)> LazyCompute;
+	typedef std::set<std::pair<int, std::shared_ptr<Impl>>> Queue;
+	
+	~Impl();
+	
+	/** Returns the source node for a subject, creating it if needed. The `subject` is kept alive as long as the node exists. */
+	static std::shared_ptr<Impl> forSubject(const std::shared_ptr<const void>& subject, const rxcpp::observable<var>& observable, const var& latestItem);
+	
+	/** Creates a node with the given inputs, and computes its initial value. */
+	static std::shared_ptr<Impl> create(const std::vector<std::shared_ptr<Impl>>& inputs, const Compute& compute);
+	
+	/** Creates a lazy node. It's not computed until it's read. */
+	static std::shared_ptr<Impl> createLazy(const LazyCompute& compute);
+	
+	/** Returns the refreshed value of the input, and adds it to the dependencies of the reading node. Must be called with the lock of the reading node held. */
+	static var read(Impl& reader, const std::shared_ptr<Impl>& input, std::vector<std::shared_ptr<Impl>>& dependencies);
+	
+	var getValue();
+	rxcpp::observable<var> asObservable();
+	
+	/** Recomputes the value first if the node is dirty. Must be called with the lock held. */
+	const var& refreshedValue();
+	
+	int rank;
+	var value;
+	Compute compute;
+	LazyCompute lazyCompute;
+	std::vector<std::shared_ptr<Impl>> inputs;
+	std::vector<std::weak_ptr<Impl>> children;
+	const std::shared_ptr<SubscriberList> subscribers;
+	std::shared_ptr<const void> subject;
+	rxcpp::composite_subscription sourceSubscription;
+	
+	/** The queue of the propagation that's going to recompute the node, or nullptr. */
+	Queue* queue;
+	
+	bool isLazy;
+	bool isDirty;
+	bool isComputing;
+	
+private:
+	/** A connected graph of nodes. If it has been merged into another graph, it forwards to that graph. */
+	struct Graph
+	{
+		CriticalSection lock;
+		std::shared_ptr<Graph> mergedInto;
+	};
+	
+	/** Holds the lock of the graph that a node currently belongs to. */
+	class GraphLock
+	{
+	public:
+		explicit GraphLock(const Impl& node);
+		~GraphLock();
+		
+	private:
+		std::shared_ptr<Graph> graph;
+		
+		JUCE_DECLARE_NON_COPYABLE(GraphLock)
+	};
+	
+	/** Thrown when a node reads a node of another graph, whose lock isn't free. The graphs must be merged without holding a lock. */
+	struct MergeNeeded
+	{
+		std::shared_ptr<Graph> first;
+		std::shared_ptr<Graph> second;
+	};
+	
+	typedef std::vector<std::pair<std::shared_ptr<Impl>, var>> Emissions;
+	typedef std::vector<std::pair<std::shared_ptr<Impl>, MergeNeeded>> Deferred;
+	
+	Impl(const std::shared_ptr<Graph>& graph);
+	
+	/** The graph of the node when it was created. Use getGraph() to find the graph it belongs to now. */
+	const std::shared_ptr<Graph> graph;
+	
+	static CriticalSection& getSourcesLock();
+	static std::map<const void*, std::weak_ptr<Impl>>& getSources();
+	
+	std::shared_ptr<Graph> getGraph() const;
+	static void merge(std::shared_ptr<Graph> first, std::shared_ptr<Graph> second);
+	static bool tryMerge(const std::shared_ptr<Graph>& lockedGraph, const std::shared_ptr<Graph>& otherGraph);
+	
+	void setInputs(const std::vector<std::shared_ptr<Impl>>& newInputs);
+	void updateRank();
+	bool isObserved() const;
+	void invalidate();
+	var recompute();
+	void sourceChanged(const var& newValue);
+	void propagate(Emissions& emissions, Deferred& deferred);
+	void refresh(Emissions& emissions, Deferred& deferred);
+	
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Impl)
+};
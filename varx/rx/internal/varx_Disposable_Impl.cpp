@@ -10,7 +10,7 @@
 
 #include "varx_Disposable_Impl.h"
 
-Disposable::Impl::Impl(const rxcpp::subscription& wrapped)
+Disposable::Impl::Impl(const rxcpp::composite_subscription& wrapped)
 : wrapped(wrapped) {}
 
 
@@ -12,9 +12,9 @@
 
 struct Disposable::Impl
 {
-	Impl(const rxcpp::subscription& wrapped);
+	Impl(const rxcpp::composite_subscription& wrapped);
 	
-	const rxcpp::subscription wrapped;
+	const rxcpp::composite_subscription wrapped;
 };
 
 
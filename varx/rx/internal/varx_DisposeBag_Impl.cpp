@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+    
+    varx_DisposeBag_Impl.cpp
+    Created: 19 Oct 2026 9:47:03pm
+    Author:  Martin Finke
+  
+  ==============================================================================
+*/
+
+#include "varx_DisposeBag_Impl.h"
+
+DisposeBag::Impl::Impl()
+: firstFree(-1),
+  numOccupied(0),
+  disposed(false) {}
+
+void DisposeBag::Impl::insert(const rxcpp::composite_subscription& subscription)
+{
+	int index = -1;
+	
+	{
+		const ScopedLock sl(lock);
+		if (!disposed) {
+			if (firstFree >= 0) {
+				index = firstFree;
+				firstFree = slots[index].nextFree;
+			}
+			else {
+				index = static_cast<int>(slots.size());
+				slots.push_back(Slot());
+			}
+			
+			Slot& slot = slots[index];
+			slot.subscription = subscription;
+			slot.nextFree = -1;
+			slot.isOccupied = true;
+			numOccupied++;
+		}
+	}
+	
+	if (index < 0) {
+		subscription.unsubscribe();
+		return;
+	}
+	
+	// Called immediately if the subscription has already been unsubscribed
+	const std::weak_ptr<Impl> weakSelf = shared_from_this();
+	subscription.add([weakSelf, index]() {
+		if (auto strongSelf = weakSelf.lock())
+			strongSelf->remove(index);
+	});
+}
+
+void DisposeBag::Impl::dispose()
+{
+	std::vector<Slot> disposedSlots;
+	
+	{
+		const ScopedLock sl(lock);
+		disposed = true;
+		disposedSlots.swap(slots);
+		firstFree = -1;
+		numOccupied = 0;
+	}
+	
+	// Outside of the lock, because unsubscribing calls remove
+	for (auto& slot : disposedSlots) {
+		if (slot.isOccupied)
+			slot.subscription.unsubscribe();
+	}
+}
+
+size_t DisposeBag::Impl::size() const
+{
+	const ScopedLock sl(lock);
+	return numOccupied;
+}
+
+void DisposeBag::Impl::remove(int index)
+{
+	const ScopedLock sl(lock);
+	if (disposed || index >= static_cast<int>(slots.size()) || !slots[index].isOccupied)
+		return;
+	
+	Slot& slot = slots[index];
+	slot.subscription = rxcpp::composite_subscription::empty();
+	slot.isOccupied = false;
+	slot.nextFree = firstFree;
+	firstFree = index;
+	numOccupied--;
+	
+	if (numOccupied == 0) {
+		std::vector<Slot>().swap(slots);
+		firstFree = -1;
+	}
+}
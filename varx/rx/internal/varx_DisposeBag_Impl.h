@@ -10,9 +10,38 @@
 
 #pragma once
 
-struct DisposeBag::Impl
+/**
+	Stores the subscriptions of a DisposeBag in slots. Free slots form a linked list (through their indexes), so inserting and removing is O(1).
+ 
+	Each inserted subscription removes itself from its slot as soon as it's unsubscribed, e.g. because its Observable has completed. When the last slot is freed, the storage is released.
+ */
+struct DisposeBag::Impl : public std::enable_shared_from_this<DisposeBag::Impl>
 {
-	const rxcpp::composite_subscription wrapped;
+public:
+	Impl();
+	
+	void insert(const rxcpp::composite_subscription& subscription);
+	
+	/** Unsubscribes all subscriptions. After this, inserted subscriptions are unsubscribed immediately. */
+	void dispose();
+	
+	size_t size() const;
+	
+private:
+	struct Slot
+	{
+		rxcpp::composite_subscription subscription;
+		int nextFree;
+		bool isOccupied;
+	};
+	
+	CriticalSection lock;
+	std::vector<Slot> slots;
+	int firstFree;
+	size_t numOccupied;
+	bool disposed;
+	
+	void remove(int index);
+	
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Impl)
 };
-
-
@@ -10,6 +10,452 @@
 
 #include "varx_Observable_Impl.h"
 
+namespace {
+	// The thread pool that's shared between all Observable::parallelMap Observables
+	ThreadPool& sharedParallelMapPool()
+	{
+		static ThreadPool pool(SystemStats::getNumCpus());
+		return pool;
+	}
+	
+	// The state of a single subscription to an Observable::flatMap Observable with limited concurrency
+	class BoundedFlatMapState : public std::enable_shared_from_this<BoundedFlatMapState>
+	{
+	public:
+		BoundedFlatMapState(const rxcpp::subscriber<var>& subscriber, const std::function<rxcpp::observable<var>(const var&)>& f, unsigned int maxConcurrent)
+		: subscriber(subscriber),
+		  f(f),
+		  maxConcurrent(maxConcurrent) {}
+		
+		void onNext(const var& item)
+		{
+			{
+				const ScopedLock lock(criticalSection);
+				
+				if (finished || pendingError || !subscriber.is_subscribed())
+					return;
+				
+				queuedItems.push_back(item);
+			}
+			
+			subscribeToQueuedItems();
+		}
+		
+		void onError(Error error)
+		{
+			{
+				const ScopedLock lock(criticalSection);
+				
+				if (finished || pendingError)
+					return;
+				
+				pendingError = error;
+				queuedItems.clear();
+			}
+			
+			drain();
+		}
+		
+		void onCompleted()
+		{
+			{
+				const ScopedLock lock(criticalSection);
+				sourceCompleted = true;
+			}
+			
+			drain();
+		}
+		
+	private:
+		const rxcpp::subscriber<var> subscriber;
+		const std::function<rxcpp::observable<var>(const var&)> f;
+		const unsigned int maxConcurrent;
+		
+		CriticalSection criticalSection;
+		std::deque<var> queuedItems;
+		std::deque<var> readyItems;
+		Error pendingError;
+		unsigned int numActive = 0;
+		bool isSubscribing = false;
+		bool isEmitting = false;
+		bool sourceCompleted = false;
+		bool finished = false;
+		
+		// Calls f and subscribes to the inner Observables without holding the lock. Only one thread subscribes at a time; inner Observables that complete synchronously (or on other threads) while it's subscribing leave their free slots to the loop below, which also avoids deep recursion.
+		void subscribeToQueuedItems()
+		{
+			{
+				const ScopedLock lock(criticalSection);
+				
+				if (isSubscribing)
+					return;
+				
+				isSubscribing = true;
+			}
+			
+			for (;;) {
+				var item;
+				
+				{
+					const ScopedLock lock(criticalSection);
+					
+					if (finished || pendingError || numActive >= maxConcurrent || queuedItems.empty()) {
+						isSubscribing = false;
+						break;
+					}
+					
+					item = queuedItems.front();
+					queuedItems.pop_front();
+					numActive++;
+				}
+				
+				rxcpp::observable<var> inner;
+				try {
+					inner = f(item);
+				}
+				catch (...) {
+					onError(std::current_exception());
+					continue;
+				}
+				
+				rxcpp::composite_subscription innerLifetime;
+				const auto weakInnerLifetime = subscriber.add(innerLifetime);
+				const auto self = shared_from_this();
+				
+				inner.subscribe(innerLifetime, [self](const var& innerItem) {
+					self->innerNext(innerItem);
+				}, [self](Error error) {
+					self->onError(error);
+				}, [self, weakInnerLifetime]() {
+					self->innerCompleted(weakInnerLifetime);
+				});
+			}
+			
+			// The source may have completed while subscribing
+			drain();
+		}
+		
+		void innerNext(const var& item)
+		{
+			{
+				const ScopedLock lock(criticalSection);
+				
+				if (finished || pendingError)
+					return;
+				
+				readyItems.push_back(item);
+			}
+			
+			drain();
+		}
+		
+		void innerCompleted(const rxcpp::weak_subscription& innerLifetime)
+		{
+			subscriber.remove(innerLifetime);
+			
+			{
+				const ScopedLock lock(criticalSection);
+				numActive--;
+			}
+			
+			subscribeToQueuedItems();
+		}
+		
+		// Emits the ready items, and then the error or completion, without holding the lock. Only one thread emits at a time, so the inner Observables' items are serialised; if another thread is already emitting, it picks up the new items.
+		void drain()
+		{
+			{
+				const ScopedLock lock(criticalSection);
+				
+				if (isEmitting)
+					return;
+				
+				isEmitting = true;
+			}
+			
+			for (;;) {
+				var item;
+				Error error;
+				bool complete = false;
+				
+				{
+					const ScopedLock lock(criticalSection);
+					
+					if (finished) {
+						isEmitting = false;
+						return;
+					}
+					
+					if (pendingError) {
+						finished = true;
+						error = pendingError;
+					}
+					else if (!readyItems.empty()) {
+						item = readyItems.front();
+						readyItems.pop_front();
+					}
+					else if (sourceCompleted && !isSubscribing && numActive == 0 && queuedItems.empty()) {
+						finished = true;
+						complete = true;
+					}
+					else {
+						isEmitting = false;
+						return;
+					}
+				}
+				
+				if (error) {
+					subscriber.on_error(error);
+					return;
+				}
+				
+				if (complete) {
+					subscriber.on_completed();
+					return;
+				}
+				
+				subscriber.on_next(item);
+			}
+		}
+		
+		JUCE_DECLARE_NON_COPYABLE(BoundedFlatMapState)
+	};
+	
+	// The state of a single subscription to an Observable::parallelMap Observable
+	class ParallelMapState : public std::enable_shared_from_this<ParallelMapState>
+	{
+	public:
+		ParallelMapState(const rxcpp::subscriber<var>& subscriber, const std::function<var(const var&)>& f, unsigned int maxConcurrency, bool preserveOrder)
+		: subscriber(subscriber),
+		  f(f),
+		  maxConcurrency(maxConcurrency),
+		  preserveOrder(preserveOrder) {}
+		
+		void onNext(const var& item)
+		{
+			const ScopedLock lock(criticalSection);
+			
+			if (finished || !subscriber.is_subscribed())
+				return;
+			
+			queuedItems.push_back(item);
+			startJobs();
+		}
+		
+		void onError(Error error)
+		{
+			{
+				const ScopedLock lock(criticalSection);
+				
+				if (finished || pendingError)
+					return;
+				
+				pendingError = error;
+				queuedItems.clear();
+			}
+			
+			drain();
+		}
+		
+		void onCompleted()
+		{
+			{
+				const ScopedLock lock(criticalSection);
+				sourceCompleted = true;
+			}
+			
+			drain();
+		}
+		
+		// Removes the jobs of this subscription that are still waiting in the pool. Jobs that are already running finish on their own.
+		void cancelJobs()
+		{
+			struct Selector : public ThreadPool::JobSelector
+			{
+				Selector(const ParallelMapState* state)
+				: state(state) {}
+				
+				bool isJobSuitable(ThreadPoolJob* job) override
+				{
+					auto parallelMapJob = dynamic_cast<Job*>(job);
+					return (parallelMapJob != nullptr && parallelMapJob->belongsTo(state));
+				}
+				
+				const ParallelMapState* const state;
+			};
+			
+			Selector selector(this);
+			sharedParallelMapPool().removeAllJobs(false, 0, &selector);
+		}
+		
+	private:
+		class Job : public ThreadPoolJob
+		{
+		public:
+			Job(const std::shared_ptr<ParallelMapState>& state, const var& item, int64 index)
+			: ThreadPoolJob("varx parallelMap"),
+			  state(state),
+			  item(item),
+			  index(index) {}
+			
+			JobStatus runJob() override
+			{
+				// The subscriber may have unsubscribed while this job was waiting in the pool
+				if (shouldExit() || !state->subscriber.is_subscribed())
+					return jobHasFinished;
+				
+				var result;
+				
+				try {
+					result = state->f(item);
+				}
+				catch (...) {
+					state->onError(std::current_exception());
+					return jobHasFinished;
+				}
+				
+				state->jobFinished(index, result);
+				return jobHasFinished;
+			}
+			
+			bool belongsTo(const ParallelMapState* otherState) const
+			{
+				return state.get() == otherState;
+			}
+			
+		private:
+			const std::shared_ptr<ParallelMapState> state;
+			const var item;
+			const int64 index;
+		};
+		
+		const rxcpp::subscriber<var> subscriber;
+		const std::function<var(const var&)> f;
+		const unsigned int maxConcurrency;
+		const bool preserveOrder;
+		
+		CriticalSection criticalSection;
+		std::deque<var> queuedItems; // Not bounded, because there's no way to slow down the source. See Observable::parallelMap.
+		std::map<int64, var> reorderBuffer;
+		std::deque<var> readyItems;
+		Error pendingError;
+		unsigned int numItemsInFlight = 0;
+		int64 nextIndex = 0;
+		int64 nextIndexToEmit = 0;
+		bool sourceCompleted = false;
+		bool isEmitting = false;
+		bool finished = false;
+		
+		// Must be called with the lock held
+		void startJobs()
+		{
+			while (numItemsInFlight < maxConcurrency && !queuedItems.empty() && subscriber.is_subscribed()) {
+				const var item = queuedItems.front();
+				queuedItems.pop_front();
+				
+				numItemsInFlight++;
+				sharedParallelMapPool().addJob(new Job(shared_from_this(), item, nextIndex++), true);
+			}
+		}
+		
+		void jobFinished(int64 index, const var& result)
+		{
+			{
+				const ScopedLock lock(criticalSection);
+				
+				if (finished || pendingError)
+					return;
+				
+				if (!subscriber.is_subscribed()) {
+					finished = true;
+					queuedItems.clear();
+					return;
+				}
+				
+				if (preserveOrder) {
+					// The result (and any held back results) is ready only if all previous results are ready
+					reorderBuffer[index] = result;
+					
+					while (!reorderBuffer.empty() && reorderBuffer.begin()->first == nextIndexToEmit) {
+						readyItems.push_back(reorderBuffer.begin()->second);
+						reorderBuffer.erase(reorderBuffer.begin());
+						nextIndexToEmit++;
+					}
+				}
+				else {
+					readyItems.push_back(result);
+				}
+			}
+			
+			drain();
+		}
+		
+		// Emits the ready items, and then the error or completion, without holding the lock. Only one thread emits at a time; if another thread is already emitting, it picks up the new items, so workers never wait for a slow subscriber.
+		void drain()
+		{
+			{
+				const ScopedLock lock(criticalSection);
+				
+				if (isEmitting)
+					return;
+				
+				isEmitting = true;
+			}
+			
+			for (;;) {
+				var item;
+				Error error;
+				bool complete = false;
+				
+				{
+					const ScopedLock lock(criticalSection);
+					
+					if (finished) {
+						isEmitting = false;
+						return;
+					}
+					
+					if (pendingError) {
+						finished = true;
+						error = pendingError;
+					}
+					else if (!readyItems.empty()) {
+						item = readyItems.front();
+						readyItems.pop_front();
+					}
+					else if (sourceCompleted && numItemsInFlight == 0 && queuedItems.empty()) {
+						finished = true;
+						complete = true;
+					}
+					else {
+						isEmitting = false;
+						return;
+					}
+				}
+				
+				if (error) {
+					subscriber.on_error(error);
+					return;
+				}
+				
+				if (complete) {
+					subscriber.on_completed();
+					return;
+				}
+				
+				subscriber.on_next(item);
+				
+				// An item stays "in flight" until it's emitted, so the reorder buffer never holds more than maxConcurrency items
+				const ScopedLock lock(criticalSection);
+				numItemsInFlight--;
+				startJobs();
+			}
+		}
+		
+		JUCE_DECLARE_NON_COPYABLE(ParallelMapState)
+	};
+}
+
 Observable::Impl::Impl(const rxcpp::observable<var>& wrapped)
 : wrapped(wrapped) {}
 
@@ -50,4 +496,89 @@ shared_ptr<Observable::Impl> Observable::Impl::fromValue(const Value& value)
 	return std::make_shared<ValueObservableImpl>(value);
 }
 
+std::shared_ptr<Observable::Impl> Observable::Impl::flatMap(const std::function<rxcpp::observable<var>(const var&)>& f, unsigned int maxConcurrent) const
+{
+	const auto source = wrapped;
+	
+	return fromRxCpp(rxcpp::observable<>::create<var>([source, f, maxConcurrent](rxcpp::subscriber<var> s) {
+		auto state = std::make_shared<BoundedFlatMapState>(s, f, maxConcurrent);
+		
+		// Use a separate lifetime for the source, so the source completing doesn't unsubscribe s while inner Observables are still active
+		rxcpp::composite_subscription sourceLifetime;
+		s.add(sourceLifetime);
+		
+		source.subscribe(rxcpp::make_subscriber<var>(sourceLifetime,
+													 [state](const var& item) { state->onNext(item); },
+													 [state](Error error) { state->onError(error); },
+													 [state]() { state->onCompleted(); }));
+	}));
+}
+
+std::shared_ptr<Observable::Impl> Observable::Impl::groupBy(const std::function<var(const var&)>& keySelector) const
+{
+	typedef rxcpp::subjects::subject<var> Group;
+	const auto source = wrapped;
+	
+	return fromRxCpp(rxcpp::observable<>::create<var>([source, keySelector](rxcpp::subscriber<var> s) {
+		// Maps each key to the Subject that emits the items of its group
+		auto groups = std::make_shared<HashMap<var, Group>>();
+		
+		const auto forEachGroup = [groups](const std::function<void(const rxcpp::subscriber<var>&)>& f) {
+			for (HashMap<var, Group>::Iterator i(*groups); i.next();)
+				f(i.getValue().get_subscriber());
+		};
+		
+		source.subscribe(s.get_subscription(), [s, groups, keySelector, forEachGroup](const var& item) {
+			var key;
+			
+			try {
+				key = keySelector(item);
+			}
+			catch (...) {
+				const auto error = std::current_exception();
+				forEachGroup([error](const rxcpp::subscriber<var>& group) { group.on_error(error); });
+				s.on_error(error);
+				return;
+			}
+			
+			if (!groups->contains(key)) {
+				const Group group;
+				groups->set(key, group);
+				s.on_next(Array<var>({key, Observable(fromRxCpp(group.get_observable()))}));
+			}
+			
+			(*groups)[key].get_subscriber().on_next(item);
+		}, [s, forEachGroup](Error error) {
+			forEachGroup([error](const rxcpp::subscriber<var>& group) { group.on_error(error); });
+			s.on_error(error);
+		}, [s, forEachGroup]() {
+			forEachGroup([](const rxcpp::subscriber<var>& group) { group.on_completed(); });
+			s.on_completed();
+		});
+	}));
+}
 
+std::shared_ptr<Observable::Impl> Observable::Impl::parallelMap(const std::function<var(const var&)>& f, unsigned int maxConcurrency, bool preserveOrder) const
+{
+	const auto source = wrapped;
+	
+	return fromRxCpp(rxcpp::observable<>::create<var>([source, f, maxConcurrency, preserveOrder](rxcpp::subscriber<var> s) {
+		auto state = std::make_shared<ParallelMapState>(s, f, maxConcurrency, preserveOrder);
+		
+		// Don't run the jobs that are still queued after unsubscribing
+		const std::weak_ptr<ParallelMapState> weakState = state;
+		s.add([weakState]() {
+			if (auto strongState = weakState.lock())
+				strongState->cancelJobs();
+		});
+		
+		// Use a separate lifetime for the source, so the source completing doesn't unsubscribe s while items are still being processed
+		rxcpp::composite_subscription sourceLifetime;
+		s.add(sourceLifetime);
+		
+		source.subscribe(rxcpp::make_subscriber<var>(sourceLifetime,
+													 [state](const var& item) { state->onNext(item); },
+													 [state](Error error) { state->onError(error); },
+													 [state]() { state->onCompleted(); }));
+	}));
+}
@@ -31,12 +31,18 @@ public:
 		return fromRxCpp(wrapped.concat(observables.impl->wrapped...));
 	}
 	
+	std::shared_ptr<Impl> flatMap(const std::function<rxcpp::observable<var>(const var&)>& f, unsigned int maxConcurrent) const;
+	
+	std::shared_ptr<Impl> groupBy(const std::function<var(const var&)>& keySelector) const;
+	
 	template<typename... Os>
 	std::shared_ptr<Impl> merge(Os&&... observables)
 	{
 		return fromRxCpp(wrapped.merge(observables.impl->wrapped...));
 	}
 	
+	std::shared_ptr<Impl> parallelMap(const std::function<var(const var&)>& f, unsigned int maxConcurrency, bool preserveOrder) const;
+	
 	template<typename... Items>
 	std::shared_ptr<Impl> startWith(Items&&... items)
 	{
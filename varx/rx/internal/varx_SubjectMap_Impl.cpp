@@ -0,0 +1,155 @@
+/*
+  ==============================================================================
+    
+    varx_SubjectMap_Impl.cpp
+    Created: 19 Oct 2026 4:05:12pm
+    Author:  Martin Finke
+  
+  ==============================================================================
+*/
+
+#include "varx_SubjectMap_Impl.h"
+
+int SubjectMap::Impl::IdentifierHash::generateHash(const Identifier& key, int upperLimit) const noexcept
+{
+	const auto address = reinterpret_cast<pointer_sized_uint>(key.getCharPointer().getAddress());
+	
+	// The lowest bits are always the same because of alignment
+	return static_cast<int>((address >> 3) % static_cast<pointer_sized_uint>(upperLimit));
+}
+
+SubjectMap::Impl::Impl()
+: SubjectEventQueue(nullptr),
+  numValues(0) {}
+
+void SubjectMap::Impl::subscribe(const Identifier& key, const rxcpp::subscriber<var>& subscriber)
+{
+	bool shouldDeliver;
+	
+	{
+		const ScopedLock sl(queueLock);
+		const int index = getOrCreateIndex(key);
+		
+		if (subscriberLists[index] == nullptr)
+			subscriberLists[index] = std::make_shared<SubscriberList>();
+		
+		shouldDeliver = queue(Event{Event::Type::Subscribe, values.getReference(index), {}, Error(), std::make_shared<const rxcpp::subscriber<var>>(subscriber), subscriberLists[index]});
+	}
+	
+	if (shouldDeliver)
+		deliverQueuedEvents();
+}
+
+void SubjectMap::Impl::setValue(const Identifier& key, const var& value)
+{
+	bool shouldDeliver;
+	
+	{
+		const ScopedLock sl(queueLock);
+		shouldDeliver = setValueAt(getOrCreateIndex(key), value);
+	}
+	
+	if (shouldDeliver)
+		deliverQueuedEvents();
+}
+
+var SubjectMap::Impl::getValue(const Identifier& key) const
+{
+	const ScopedLock sl(queueLock);
+	
+	if (!indices.contains(key))
+		return var::undefined();
+	
+	return values.getReference(indices[key]);
+}
+
+int SubjectMap::Impl::size() const
+{
+	const ScopedLock sl(queueLock);
+	return numValues;
+}
+
+NamedValueSet SubjectMap::Impl::getValues() const
+{
+	const ScopedLock sl(queueLock);
+	NamedValueSet result;
+	
+	for (int i = 0; i < keys.size(); ++i) {
+		if (!values.getReference(i).isUndefined())
+			result.set(keys.getReference(i), values.getReference(i));
+	}
+	
+	return result;
+}
+
+void SubjectMap::Impl::setValues(const NamedValueSet& newValues)
+{
+	bool shouldDeliver = false;
+	
+	{
+		const ScopedLock sl(queueLock);
+		
+		for (int i = 0; i < newValues.size(); ++i) {
+			if (setValueAt(getOrCreateIndex(newValues.getName(i)), newValues.getValueAt(i)))
+				shouldDeliver = true;
+		}
+	}
+	
+	if (shouldDeliver)
+		deliverQueuedEvents();
+}
+
+int SubjectMap::Impl::getOrCreateIndex(const Identifier& key)
+{
+	if (indices.contains(key))
+		return indices[key];
+	
+	const int index = keys.size();
+	indices.set(key, index);
+	keys.add(key);
+	values.add(var::undefined());
+	subscriberLists.push_back(nullptr);
+	
+	return index;
+}
+
+bool SubjectMap::Impl::setValueAt(int index, const var& value)
+{
+	// Must be called with the queue lock held. Returns true if the caller should deliver the queued events.
+	var& currentValue = values.getReference(index);
+	
+	if (value.equalsWithSameType(currentValue))
+		return false;
+	
+	if (currentValue.isUndefined())
+		numValues++;
+	else if (value.isUndefined())
+		numValues--;
+	
+	currentValue = value;
+	
+	if (auto subscribers = subscriberLists[index])
+		return queue(Event{Event::Type::Next, value, {}, Error(), nullptr, subscribers});
+	
+	return false;
+}
+
+void SubjectMap::Impl::deliver(const Event& event)
+{
+	switch (event.type) {
+		case Event::Type::Next:
+			event.target->onNext(event.item);
+			break;
+		case Event::Type::Subscribe:
+			// An undefined value means that the key hasn't been set yet
+			if (!event.item.isUndefined())
+				event.subscriber->on_next(event.item);
+			
+			event.target->add(*event.subscriber);
+			break;
+		default:
+			// The map never terminates
+			jassertfalse;
+			break;
+	}
+}
@@ -0,0 +1,52 @@
+/*
+  ==============================================================================
+    
+    varx_SubjectMap_Impl.h
+    Created: 19 Oct 2026 4:05:12pm
+    Author:  Martin Finke
+  
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "varx_Subjects_Impl.h"
+
+/**
+	The values, and the subscriber lists of the keys that are observed. Everything is guarded by the queue lock.
+ 
+	Items are delivered through the SubjectEventQueue, without holding the lock. So subscribers can access the map, and each subscriber still gets the values of its key in order.
+ */
+struct SubjectMap::Impl : private SubjectEventQueue
+{
+public:
+	Impl();
+	
+	void subscribe(const Identifier& key, const rxcpp::subscriber<var>& subscriber);
+	void setValue(const Identifier& key, const var& value);
+	var getValue(const Identifier& key) const;
+	int size() const;
+	NamedValueSet getValues() const;
+	void setValues(const NamedValueSet& values);
+	
+private:
+	// Identifiers are pooled, so they can be hashed by their address instead of their characters
+	struct IdentifierHash
+	{
+		int generateHash(const Identifier& key, int upperLimit) const noexcept;
+	};
+	
+	HashMap<Identifier, int, IdentifierHash> indices;
+	
+	// The table, indexed by the values in `indices`. The subscriber lists are only created when a key is observed.
+	Array<Identifier> keys;
+	Array<var> values;
+	std::vector<std::shared_ptr<SubscriberList>> subscriberLists;
+	int numValues;
+	
+	int getOrCreateIndex(const Identifier& key);
+	bool setValueAt(int index, const var& value);
+	void deliver(const Event& event) override;
+	
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Impl)
+};
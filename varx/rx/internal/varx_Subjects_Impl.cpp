@@ -16,45 +16,862 @@ var Subject::Impl::getLatestItem() const
 	return var::undefined();
 }
 
+std::shared_ptr<SubscriberList> Subject::Impl::getSubscriberList() const
+{
+	return nullptr;
+}
+
+ThreadLocalValue<Subject::Transaction::Impl*>& Subject::Transaction::Impl::current()
+{
+	static ThreadLocalValue<Impl*> value;
+	return value;
+}
+
+Subject::Transaction::Impl::Impl()
+: isOutermost(current().get() == nullptr),
+  committing(false),
+  committed(false)
+{
+	if (isOutermost)
+		current() = this;
+}
+
+Subject::Transaction::Impl* Subject::Transaction::Impl::getCurrent()
+{
+	return current().get();
+}
+
+bool Subject::Transaction::Impl::isCommitting() const
+{
+	return committing;
+}
+
+void Subject::Transaction::Impl::addPendingList(const std::shared_ptr<SubscriberList>& subscriberList)
+{
+	pendingLists.push_back(subscriberList);
+}
+
+void Subject::Transaction::Impl::addBatchedFlush(const std::function<void()>& flush)
+{
+	batchedFlushes.push_back(flush);
+}
+
+void Subject::Transaction::Impl::commit()
+{
+	// Inner transactions are committed by the outermost one
+	if (!isOutermost || committed)
+		return;
+	
+	committed = true;
+	committing = true;
+	
+	// If a subscriber throws, the other items are still emitted, and the transaction is closed. Then the first exception is rethrown.
+	std::exception_ptr firstException;
+	
+	// Emit the deferred items. Items emitted from now on are not deferred anymore.
+	for (size_t i = 0; i < pendingLists.size(); ++i) {
+		try {
+			pendingLists[i]->emitPendingItem();
+		}
+		catch (...) {
+			if (!firstException)
+				firstException = std::current_exception();
+		}
+	}
+	
+	pendingLists.clear();
+	
+	// Now all Subjects have their new items, so let each Observable::batched emit once
+	while (!batchedFlushes.empty()) {
+		const std::function<void()> flush = batchedFlushes.front();
+		batchedFlushes.pop_front();
+		
+		try {
+			flush();
+		}
+		catch (...) {
+			if (!firstException)
+				firstException = std::current_exception();
+		}
+	}
+	
+	committing = false;
+	current() = nullptr;
+	
+	if (firstException)
+		std::rethrow_exception(firstException);
+}
+
+SubscriberList::SubscriberList(bool defersItems)
+: entries(new Entries()),
+  nextId(0),
+  numReserved(0),
+  state(State::Active),
+  defersItems(defersItems),
+  hasPendingItem(false),
+  nextCountSequenceNumber(0) {}
+
+SubscriberList::~SubscriberList()
+{
+	for (auto reclaimed : reclaimedEntries)
+		delete reclaimed;
+}
+
+void SubscriberList::add(const rxcpp::subscriber<var>& subscriber, const std::function<var()>& getInitialItem, bool isReserved)
+{
+	if (!isReserved)
+		reserve();
+	
+	if (getInitialItem != nullptr && isActive())
+		subscriber.on_next(getInitialItem());
+	
+	State currentState;
+	Error currentError;
+	int64 id;
+	
+	{
+		const ScopedLock lock(writeLock);
+		currentState = state;
+		currentError = error;
+		id = nextId++;
+		
+		if (state == State::Active) {
+			// The subscriber has been counted by reserve, so the count doesn't change. A termination resets the reservations.
+			jassert(numReserved > 0);
+			--numReserved;
+			
+			auto newEntries = new Entries(*entries.load());
+			newEntries->push_back(Entry{id, subscriber});
+			publish(newEntries);
+		}
+	}
+	
+	deleteReclaimedEntries();
+	
+	switch (currentState) {
+		case State::Active: {
+			// Remove the subscriber when it unsubscribes. Capture weakly, because the subscriber is in the list.
+			std::weak_ptr<SubscriberList> weakThis = shared_from_this();
+			subscriber.add([weakThis, id]() {
+				if (auto strongThis = weakThis.lock())
+					strongThis->remove(id);
+			});
+			break;
+		}
+		case State::Completed:
+			subscriber.on_completed();
+			break;
+		case State::Failed:
+			subscriber.on_error(currentError);
+			break;
+		case State::Disposed:
+			subscriber.unsubscribe();
+			break;
+	}
+}
+
+void SubscriberList::reserve()
+{
+	CountNotification countNotification;
+	
+	{
+		const ScopedLock lock(writeLock);
+		if (state != State::Active)
+			return;
+		
+		++numReserved;
+		countNotification = prepareCountNotification();
+	}
+	
+	countNotification.send();
+}
+
+bool SubscriberList::isActive() const
+{
+	const ScopedLock lock(writeLock);
+	return state == State::Active;
+}
+
+bool SubscriberList::isEmpty() const
+{
+	return Snapshot(entries)->empty();
+}
+
+size_t SubscriberList::size() const
+{
+	return Snapshot(entries)->size();
+}
+
+void SubscriberList::setCountCallback(const CountCallback& callback)
+{
+	const ScopedLock lock(writeLock);
+	countCallback = (callback != nullptr ? std::make_shared<const CountCallback>(callback) : nullptr);
+}
+
+SubscriberList::CountNotification SubscriberList::prepareCountNotification()
+{
+	// Must be called with the write lock held, right after the entries or reservations have changed
+	return CountNotification{countCallback, entries.load()->size() + numReserved, nextCountSequenceNumber++};
+}
+
+void SubscriberList::CountNotification::send() const
+{
+	if (callback != nullptr)
+		(*callback)(numSubscribers, sequenceNumber);
+}
+
+void SubscriberList::onNext(const var& next)
+{
+	auto transaction = (defersItems ? Subject::Transaction::Impl::getCurrent() : nullptr);
+	
+	if (transaction == nullptr || transaction->isCommitting()) {
+		emit(next);
+		return;
+	}
+	
+	bool isFirstPendingItem;
+	
+	{
+		const ScopedLock lock(writeLock);
+		pendingItem = next;
+		isFirstPendingItem = !hasPendingItem;
+		hasPendingItem = true;
+	}
+	
+	if (isFirstPendingItem)
+		transaction->addPendingList(shared_from_this());
+}
+
+void SubscriberList::emitPendingItem()
+{
+	var item;
+	
+	{
+		const ScopedLock lock(writeLock);
+		if (!hasPendingItem)
+			return;
+		
+		item = pendingItem;
+		pendingItem = var();
+		hasPendingItem = false;
+	}
+	
+	emit(item);
+}
+
+void SubscriberList::emit(const var& next) const
+{
+	const Snapshot snapshot(entries);
+	
+	for (const Entry& entry : *snapshot)
+		entry.subscriber.on_next(next);
+}
+
+void SubscriberList::publish(Entries* newEntries)
+{
+	// Must be called with the write lock held. The caller calls deleteReclaimedEntries after releasing the lock.
+	entries.publish(newEntries, reclaimedEntries);
+}
+
+void SubscriberList::deleteReclaimedEntries()
+{
+	std::vector<Entries*> entriesToDelete;
+	
+	{
+		const ScopedLock lock(writeLock);
+		if (reclaimedEntries.empty())
+			return;
+		
+		entriesToDelete.swap(reclaimedEntries);
+	}
+	
+	// Deleting the entries releases subscribers, so do it outside of the lock
+	for (auto reclaimed : entriesToDelete)
+		delete reclaimed;
+}
+
+void SubscriberList::onError(Error newError)
+{
+	terminate(State::Failed, newError);
+}
+
+void SubscriberList::onCompleted()
+{
+	terminate(State::Completed, Error());
+}
+
+void SubscriberList::dispose()
+{
+	terminate(State::Disposed, Error());
+}
+
+void SubscriberList::remove(int64 id)
+{
+	CountNotification countNotification;
+	
+	{
+		const ScopedLock lock(writeLock);
+		const Entries& currentEntries = *entries.load();
+		const auto it = std::find_if(currentEntries.begin(), currentEntries.end(), [id](const Entry& entry) { return entry.id == id; });
+		
+		// The subscriber may have been removed by a termination already
+		if (it == currentEntries.end())
+			return;
+		
+		auto newEntries = new Entries();
+		newEntries->reserve(currentEntries.size() - 1);
+		newEntries->insert(newEntries->end(), currentEntries.begin(), it);
+		newEntries->insert(newEntries->end(), it + 1, currentEntries.end());
+		
+		publish(newEntries);
+		countNotification = prepareCountNotification();
+	}
+	
+	deleteReclaimedEntries();
+	countNotification.send();
+}
+
+void SubscriberList::terminate(State newState, Error newError)
+{
+	// An item that has been deferred by a transaction is emitted before the termination
+	if (newState != State::Disposed)
+		emitPendingItem();
+	
+	Entries terminatedEntries;
+	CountNotification countNotification;
+	
+	{
+		const ScopedLock lock(writeLock);
+		if (state != State::Active)
+			return;
+		
+		state = newState;
+		error = newError;
+		terminatedEntries = *entries.load();
+		publish(new Entries());
+		
+		if (!terminatedEntries.empty() || numReserved > 0) {
+			numReserved = 0;
+			countNotification = prepareCountNotification();
+		}
+	}
+	
+	deleteReclaimedEntries();
+	countNotification.send();
+	
+	// Notify outside of the lock, so that the subscribers can subscribe again
+	for (const Entry& entry : terminatedEntries) {
+		if (newState == State::Completed)
+			entry.subscriber.on_completed();
+		else if (newState == State::Failed)
+			entry.subscriber.on_error(newError);
+	}
+}
+
+SubjectEventQueue::SubjectEventQueue(const std::shared_ptr<SubscriberList>& subscribers)
+: subscribers(subscribers),
+  nextEvent(0),
+  isDelivering(false) {}
+
+void SubjectEventQueue::onError(Error error)
+{
+	bool shouldDeliver;
+	
+	{
+		const ScopedLock sl(queueLock);
+		shouldDeliver = queue(Event{Event::Type::Error, var(), {}, error, nullptr});
+	}
+	
+	if (shouldDeliver)
+		deliverQueuedEvents();
+}
+
+void SubjectEventQueue::onCompleted()
+{
+	bool shouldDeliver;
+	
+	{
+		const ScopedLock sl(queueLock);
+		shouldDeliver = queue(Event{Event::Type::Completed, var(), {}, Error(), nullptr});
+	}
+	
+	if (shouldDeliver)
+		deliverQueuedEvents();
+}
+
+void SubjectEventQueue::dispose()
+{
+	subscribers->dispose();
+}
+
+bool SubjectEventQueue::queue(Event&& event)
+{
+	// Must be called with the queue lock held. Returns true if the caller should deliver the queued events.
+	events.push_back(std::move(event));
+	
+	if (isDelivering)
+		return false;
+	
+	isDelivering = true;
+	return true;
+}
+
+void SubjectEventQueue::deliverQueuedEvents()
+{
+	try {
+		for (;;) {
+			Event event;
+			
+			{
+				const ScopedLock sl(queueLock);
+				
+				if (nextEvent == events.size()) {
+					// Keep the capacity, so that queueing doesn't allocate
+					events.clear();
+					nextEvent = 0;
+					isDelivering = false;
+					return;
+				}
+				
+				event = std::move(events[nextEvent]);
+				events[nextEvent++] = Event();
+			}
+			
+			deliver(event);
+		}
+	}
+	catch (...) {
+		// A subscriber has thrown: Let the next call deliver the remaining events
+		const ScopedLock sl(queueLock);
+		isDelivering = false;
+		throw;
+	}
+}
+
+void SubjectEventQueue::deliver(const Event& event)
+{
+	switch (event.type) {
+		case Event::Type::Next:
+			subscribers->onNext(event.item);
+			break;
+		case Event::Type::Subscribe:
+			subscribers->add(*event.subscriber);
+			break;
+		case Event::Type::Error:
+			subscribers->onError(event.error);
+			break;
+		case Event::Type::Completed:
+			subscribers->onCompleted();
+			break;
+	}
+}
+
+BehaviorSubjectImpl::State::State(const var& initial)
+: SubjectEventQueue(std::make_shared<SubscriberList>(true)),
+  latestItem(new var(initial)) {}
+
+BehaviorSubjectImpl::State::~State()
+{
+	for (auto item : freeItems)
+		delete item;
+}
+
+var BehaviorSubjectImpl::State::getLatestItem() const
+{
+	const EpochPointer<var>::Reader reader(latestItem);
+	return *reader;
+}
+
+void BehaviorSubjectImpl::State::onNext(const var& next)
+{
+	bool shouldDeliver;
+	
+	{
+		const ScopedLock sl(queueLock);
+		
+		var* item;
+		if (freeItems.empty())
+			item = new var(next);
+		else {
+			item = freeItems.back();
+			freeItems.pop_back();
+			*item = next;
+		}
+		
+		const size_t numFreeItems = freeItems.size();
+		latestItem.publish(item, freeItems);
+		
+		// Don't keep reclaimed items alive until their slots are reused
+		for (size_t i = numFreeItems; i < freeItems.size(); ++i)
+			*freeItems[i] = var();
+		
+		shouldDeliver = queue(Event{Event::Type::Next, next, {}, Error(), nullptr});
+	}
+	
+	if (shouldDeliver)
+		deliverQueuedEvents();
+}
+
+void BehaviorSubjectImpl::State::subscribe(const rxcpp::subscriber<var>& subscriber)
+{
+	// Count the subscriber first, so that the count callback can update the latest item before it's taken as the initial item
+	subscribers->reserve();
+	
+	bool shouldDeliver;
+	
+	{
+		const ScopedLock sl(queueLock);
+		shouldDeliver = queue(Event{Event::Type::Subscribe, getLatestItem(), {}, Error(), std::make_shared<const rxcpp::subscriber<var>>(subscriber)});
+	}
+	
+	if (shouldDeliver)
+		deliverQueuedEvents();
+}
+
+void BehaviorSubjectImpl::State::deliver(const Event& event)
+{
+	if (event.type != Event::Type::Subscribe) {
+		SubjectEventQueue::deliver(event);
+		return;
+	}
+	
+	// After onError or onCompleted, a new subscriber is just notified of the termination
+	const var initialItem = event.item;
+	subscribers->add(*event.subscriber, [initialItem]() { return initialItem; }, true);
+}
+
 BehaviorSubjectImpl::BehaviorSubjectImpl(const juce::var& initial)
-: wrapped(initial) {}
+: state(std::make_shared<State>(initial))
+{
+	// Like rxcpp's subjects: If the subscriber side is unsubscribed, the current subscribers are dropped without being notified.
+	std::weak_ptr<State> weakState = state;
+	lifetime.add([weakState]() {
+		if (auto strongState = weakState.lock())
+			strongState->dispose();
+	});
+}
 
 rxcpp::subscriber<var> BehaviorSubjectImpl::getSubscriber() const
 {
-	return wrapped.get_subscriber();
+	const std::shared_ptr<State> state = this->state;
+	
+	return rxcpp::make_subscriber<var>(lifetime, rxcpp::make_observer_dynamic<var>([state](const var& next) {
+		state->onNext(next);
+	}, [state](Error error) {
+		state->onError(error);
+	}, [state]() {
+		state->onCompleted();
+	}));
 }
 
 rxcpp::observable<var> BehaviorSubjectImpl::asObservable() const
 {
-	return wrapped.get_observable();
+	const std::shared_ptr<State> state = this->state;
+	
+	return rxcpp::observable<>::create<var>([state](rxcpp::subscriber<var> s) {
+		state->subscribe(s);
+	});
 }
 
 var BehaviorSubjectImpl::getLatestItem() const
 {
-	return wrapped.get_value();
+	return state->getLatestItem();
 }
 
-PublishSubjectImpl::PublishSubjectImpl() {}
+std::shared_ptr<SubscriberList> BehaviorSubjectImpl::getSubscriberList() const
+{
+	return state->subscribers;
+}
+
+PublishSubjectImpl::PublishSubjectImpl()
+: subscribers(std::make_shared<SubscriberList>())
+{
+	// Like rxcpp's subjects: If the subscriber side is unsubscribed, the current subscribers are dropped without being notified.
+	std::weak_ptr<SubscriberList> weakSubscribers = subscribers;
+	lifetime.add([weakSubscribers]() {
+		if (auto strongSubscribers = weakSubscribers.lock())
+			strongSubscribers->dispose();
+	});
+}
 
 rxcpp::subscriber<var> PublishSubjectImpl::getSubscriber() const
 {
-	return wrapped.get_subscriber();
+	const std::shared_ptr<SubscriberList> subscribers = this->subscribers;
+	
+	return rxcpp::make_subscriber<var>(lifetime, rxcpp::make_observer_dynamic<var>([subscribers](const var& next) {
+		subscribers->onNext(next);
+	}, [subscribers](Error error) {
+		subscribers->onError(error);
+	}, [subscribers]() {
+		subscribers->onCompleted();
+	}));
 }
 
 rxcpp::observable<var> PublishSubjectImpl::asObservable() const
 {
-	return wrapped.get_observable();
+	const std::shared_ptr<SubscriberList> subscribers = this->subscribers;
+	
+	return rxcpp::observable<>::create<var>([subscribers](rxcpp::subscriber<var> s) {
+		subscribers->add(s);
+	});
+}
+
+std::shared_ptr<SubscriberList> PublishSubjectImpl::getSubscriberList() const
+{
+	return subscribers;
+}
+
+ReplaySubjectImpl::Buffer::Buffer(size_t maxSize, double windowMilliseconds)
+: SubjectEventQueue(std::make_shared<SubscriberList>(false)),
+  first(0),
+  count(0),
+  maxSize(maxSize),
+  windowMilliseconds(windowMilliseconds)
+{
+	if (maxSize != ReplaySubject::MaxBufferSize)
+		items.resize(maxSize);
+}
+
+void ReplaySubjectImpl::Buffer::onNext(const var& next)
+{
+	bool shouldDeliver;
+	
+	{
+		const ScopedLock sl(queueLock);
+		const double now = Time::getMillisecondCounterHiRes();
+		removeExpiredItems(now);
+		
+		if (maxSize > 0) {
+			if (count == items.size())
+				grow();
+			
+			if (count < items.size()) {
+				Item& item = items[(first + count) % items.size()];
+				item.value = next;
+				item.time = now;
+				count++;
+			}
+			else {
+				// The buffer is full: Overwrite the oldest item
+				Item& item = items[first];
+				item.value = next;
+				item.time = now;
+				first = (first + 1) % items.size();
+			}
+		}
+		
+		shouldDeliver = queue(Event{Event::Type::Next, next, {}, Error(), nullptr});
+	}
+	
+	if (shouldDeliver)
+		deliverQueuedEvents();
+}
+
+void ReplaySubjectImpl::Buffer::subscribe(const rxcpp::subscriber<var>& subscriber)
+{
+	bool shouldDeliver;
+	
+	{
+		const ScopedLock sl(queueLock);
+		removeExpiredItems(Time::getMillisecondCounterHiRes());
+		
+		std::vector<var> replayedItems;
+		replayedItems.reserve(count);
+		for (size_t i = 0; i < count; ++i)
+			replayedItems.push_back(items[(first + i) % items.size()].value);
+		
+		shouldDeliver = queue(Event{Event::Type::Subscribe, var(), std::move(replayedItems), Error(), std::make_shared<const rxcpp::subscriber<var>>(subscriber)});
+	}
+	
+	if (shouldDeliver)
+		deliverQueuedEvents();
 }
 
-ReplaySubjectImpl::ReplaySubjectImpl(size_t bufferSize)
-: wrapped(bufferSize, rxcpp::identity_immediate()) {}
+void ReplaySubjectImpl::Buffer::deliver(const Event& event)
+{
+	if (event.type != Event::Type::Subscribe) {
+		SubjectEventQueue::deliver(event);
+		return;
+	}
+	
+	for (size_t i = 0; i < event.replayedItems.size() && event.subscriber->is_subscribed(); ++i)
+		event.subscriber->on_next(event.replayedItems[i]);
+	
+	subscribers->add(*event.subscriber);
+}
+
+void ReplaySubjectImpl::Buffer::removeExpiredItems(double now)
+{
+	while (count > 0 && now - items[first].time > windowMilliseconds) {
+		items[first].value = var();
+		first = (first + 1) % items.size();
+		count--;
+	}
+}
+
+void ReplaySubjectImpl::Buffer::grow()
+{
+	// Only an unlimited buffer grows
+	if (maxSize != ReplaySubject::MaxBufferSize)
+		return;
+	
+	std::vector<Item> newItems(jmax<size_t>(16, items.size() * 2));
+	for (size_t i = 0; i < count; ++i)
+		newItems[i] = items[(first + i) % items.size()];
+	
+	items.swap(newItems);
+	first = 0;
+}
+
+ReplaySubjectImpl::ReplaySubjectImpl(size_t bufferSize, double windowMilliseconds)
+: buffer(std::make_shared<Buffer>(bufferSize, windowMilliseconds))
+{
+	// Like rxcpp's subjects: If the subscriber side is unsubscribed, the current subscribers are dropped without being notified.
+	std::weak_ptr<Buffer> weakBuffer = buffer;
+	lifetime.add([weakBuffer]() {
+		if (auto strongBuffer = weakBuffer.lock())
+			strongBuffer->dispose();
+	});
+}
 
 rxcpp::subscriber<var> ReplaySubjectImpl::getSubscriber() const
 {
-	return wrapped.get_subscriber();
+	const std::shared_ptr<Buffer> buffer = this->buffer;
+	
+	return rxcpp::make_subscriber<var>(lifetime, rxcpp::make_observer_dynamic<var>([buffer](const var& next) {
+		buffer->onNext(next);
+	}, [buffer](Error error) {
+		buffer->onError(error);
+	}, [buffer]() {
+		buffer->onCompleted();
+	}));
 }
 
 rxcpp::observable<var> ReplaySubjectImpl::asObservable() const
 {
-	return wrapped.get_observable();
+	const std::shared_ptr<Buffer> buffer = this->buffer;
+	
+	return rxcpp::observable<>::create<var>([buffer](rxcpp::subscriber<var> s) {
+		buffer->subscribe(s);
+	});
+}
+
+std::shared_ptr<SubscriberList> ReplaySubjectImpl::getSubscriberList() const
+{
+	return buffer->subscribers;
+}
+
+ConflatingSubjectImpl::State::State(const std::shared_ptr<Scheduler::Impl>& scheduler)
+: SubjectEventQueue(std::make_shared<SubscriberList>()),
+  hasPendingItem(false),
+  scheduler(scheduler) {}
+
+void ConflatingSubjectImpl::State::onNext(const var& next)
+{
+	bool needsFlush;
+	
+	{
+		const ScopedLock sl(queueLock);
+		pendingItem = next;
+		needsFlush = !hasPendingItem;
+		hasPendingItem = true;
+	}
+	
+	if (needsFlush) {
+		// Keep the state alive until the flush, so the pending item is delivered even if the subject is gone
+		const std::shared_ptr<State> strongThis = shared_from_this();
+		scheduler->schedule(rxcpp::observable<>::just(var())).subscribe([strongThis](const var&) {
+			strongThis->flush();
+		});
+	}
+}
+
+void ConflatingSubjectImpl::State::onError(Error error)
+{
+	terminate(Event{Event::Type::Error, var(), {}, error, nullptr});
+}
+
+void ConflatingSubjectImpl::State::onCompleted()
+{
+	terminate(Event{Event::Type::Completed, var(), {}, Error(), nullptr});
+}
+
+void ConflatingSubjectImpl::State::subscribe(const rxcpp::subscriber<var>& subscriber)
+{
+	subscribers->add(subscriber);
+}
+
+void ConflatingSubjectImpl::State::flush()
+{
+	bool shouldDeliver;
+	
+	{
+		const ScopedLock sl(queueLock);
+		shouldDeliver = queuePendingItem();
+	}
+	
+	if (shouldDeliver)
+		deliverQueuedEvents();
+}
+
+bool ConflatingSubjectImpl::State::queuePendingItem()
+{
+	// Must be called with the queue lock held. Returns true if the caller should deliver the queued events.
+	if (!hasPendingItem)
+		return false;
+	
+	Event event{Event::Type::Next, var(), {}, Error(), nullptr};
+	std::swap(event.item, pendingItem);
+	hasPendingItem = false;
+	
+	return queue(std::move(event));
+}
+
+void ConflatingSubjectImpl::State::terminate(Event&& event)
+{
+	bool shouldDeliver;
+	
+	{
+		const ScopedLock sl(queueLock);
+		
+		// The pending item is emitted before the termination
+		const bool shouldDeliverPendingItem = queuePendingItem();
+		shouldDeliver = queue(std::move(event)) || shouldDeliverPendingItem;
+	}
+	
+	if (shouldDeliver)
+		deliverQueuedEvents();
+}
+
+ConflatingSubjectImpl::ConflatingSubjectImpl(const std::shared_ptr<Scheduler::Impl>& scheduler)
+: state(std::make_shared<State>(scheduler))
+{
+	// Like rxcpp's subjects: If the subscriber side is unsubscribed, the current subscribers are dropped without being notified.
+	std::weak_ptr<State> weakState = state;
+	lifetime.add([weakState]() {
+		if (auto strongState = weakState.lock())
+			strongState->dispose();
+	});
+}
+
+rxcpp::subscriber<var> ConflatingSubjectImpl::getSubscriber() const
+{
+	const std::shared_ptr<State> state = this->state;
+	
+	return rxcpp::make_subscriber<var>(lifetime, rxcpp::make_observer_dynamic<var>([state](const var& next) {
+		state->onNext(next);
+	}, [state](Error error) {
+		state->onError(error);
+	}, [state]() {
+		state->onCompleted();
+	}));
+}
+
+rxcpp::observable<var> ConflatingSubjectImpl::asObservable() const
+{
+	const std::shared_ptr<State> state = this->state;
+	
+	return rxcpp::observable<>::create<var>([state](rxcpp::subscriber<var> s) {
+		state->subscribe(s);
+	});
 }
@@ -17,6 +17,319 @@ public:
 	virtual rxcpp::subscriber<var> getSubscriber() const = 0;
 	virtual rxcpp::observable<var> asObservable() const = 0;
 	virtual var getLatestItem() const;
+	
+	/** Returns the subscribers of the subject, or nullptr if the subject doesn't keep a SubscriberList. */
+	virtual std::shared_ptr<SubscriberList> getSubscriberList() const;
+};
+
+class SubscriberList;
+
+/**
+	The state of a Subject::Transaction. The outermost transaction on a thread is the current one, inner transactions just join it.
+ 
+	While the transaction is open, SubscriberLists defer their items to the transaction. When it's committed, each deferred item is emitted, and then each Observable::batched emits its latest item.
+ */
+struct Subject::Transaction::Impl
+{
+public:
+	Impl();
+	
+	/** Returns the open transaction on the calling thread, or nullptr. */
+	static Impl* getCurrent();
+	
+	/** Returns true if the transaction is being committed. In this case, items aren't deferred anymore. */
+	bool isCommitting() const;
+	
+	void addPendingList(const std::shared_ptr<SubscriberList>& subscriberList);
+	void addBatchedFlush(const std::function<void()>& flush);
+	
+	void commit();
+	
+private:
+	static ThreadLocalValue<Impl*>& current();
+	
+	const bool isOutermost;
+	bool committing;
+	bool committed;
+	std::vector<std::shared_ptr<SubscriberList>> pendingLists;
+	std::deque<std::function<void()>> batchedFlushes;
+	
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Impl)
+};
+
+/**
+	A pointer that can be read without taking a lock. Writers replace it while holding a lock of the owner, so there's only one writer at a time.
+ 
+	A Reader pins the current object: It registers with the reader count of the current epoch (there are two), and then loads the pointer. When a writer replaces the object, the old one is retired in the current epoch. Once the other epoch has no readers left, the objects retired in it are handed back to the writer, and the epoch is flipped. Readers that start after a flip register with the new epoch, so the old epoch drains even while other threads keep reading.
+ 
+	Only writers reclaim objects, so reading never takes a lock or frees memory. A retired object stays alive until the next publish after its readers are done, so at most the objects that were replaced during the longest-running read are kept.
+ */
+template <typename T>
+class EpochPointer
+{
+public:
+	explicit EpochPointer(T* initial)
+	: current(initial),
+	  epoch(0)
+	{
+		numReaders[0] = 0;
+		numReaders[1] = 0;
+	}
+	
+	~EpochPointer()
+	{
+		delete current.load();
+		
+		for (auto& objects : retired) {
+			for (auto object : objects)
+				delete object;
+		}
+	}
+	
+	/** Pins the current object while it's read. Doesn't take any lock. */
+	class Reader
+	{
+	public:
+		explicit Reader(const EpochPointer& pointer)
+		: numReaders(pointer.numReaders[pointer.epoch.load()])
+		{
+			// Registering before loading: A writer that sees no readers in this epoch has replaced the object before it was loaded here
+			++numReaders;
+			object = pointer.current.load();
+		}
+		
+		~Reader()
+		{
+			--numReaders;
+		}
+		
+		const T& operator*() const
+		{
+			return *object;
+		}
+		
+		const T* operator->() const
+		{
+			return object;
+		}
+		
+	private:
+		std::atomic<int>& numReaders;
+		const T* object;
+		
+		JUCE_DECLARE_NON_COPYABLE(Reader)
+	};
+	
+	/** Returns the current object. Must be called with the owner's write lock held. */
+	T* load() const
+	{
+		return current.load();
+	}
+	
+	/**
+		Replaces the current object. Must be called with the owner's write lock held.
+	 
+		The objects that no reader can see anymore are appended to `reclaimed`. They belong to the caller now, which should delete (or reuse) them, preferably after releasing its lock.
+	 */
+	void publish(T* newObject, std::vector<T*>& reclaimed)
+	{
+		int currentEpoch = epoch.load();
+		retired[currentEpoch].push_back(current.exchange(newObject));
+		
+		// First reclaim the other epoch, then flip and try to reclaim the object that has just been retired
+		for (int i = 0; i < 2; ++i) {
+			const int otherEpoch = 1 - currentEpoch;
+			if (numReaders[otherEpoch] != 0)
+				return;
+			
+			reclaimed.insert(reclaimed.end(), retired[otherEpoch].begin(), retired[otherEpoch].end());
+			retired[otherEpoch].clear();
+			
+			if (retired[currentEpoch].empty())
+				return;
+			
+			epoch = otherEpoch;
+			currentEpoch = otherEpoch;
+		}
+	}
+	
+private:
+	std::atomic<T*> current;
+	std::atomic<int> epoch;
+	mutable std::atomic<int> numReaders[2];
+	std::vector<T*> retired[2];
+	
+	JUCE_DECLARE_NON_COPYABLE(EpochPointer)
+};
+
+/**
+	A list of subscribers, which can be notified without taking the list's lock.
+ 
+	The list is copy-on-write: Adding or removing a subscriber copies the list under a lock and publishes the new copy through an EpochPointer. onNext just pins the current copy and iterates it, without taking any lock or freeing memory. Old copies are deleted by later writers once no reader can see them anymore, so concurrent onNext calls on different lists don't contend at all, and sustained onNext calls from several threads don't keep old copies alive.
+ 
+	After onError or onCompleted, the list is terminated: It's cleared, and new subscribers are notified of the error or completion immediately. After dispose, the list is cleared and new subscribers are unsubscribed immediately.
+ 
+	A count callback can be set to find out when the list gets its first subscriber, or loses its last one (e.g. to register a listener only while needed).
+ 
+	If the list defers items, and onNext is called while a Subject::Transaction is open, the item isn't emitted until the transaction is committed. Multiple deferred items are collapsed into the latest one. Only the lists of BehaviorSubjects defer items, because collapsing them can't lose a state. Other subjects emit events or replay every item, so their items must not be dropped.
+ */
+class SubscriberList : public std::enable_shared_from_this<SubscriberList>
+{
+public:
+	/** Creates an empty list. If `defersItems` is true, items are deferred while a Subject::Transaction is open. */
+	explicit SubscriberList(bool defersItems = false);
+	~SubscriberList();
+	
+	/**
+		Adds a subscriber. If `getInitialItem` is given and the list is active, the subscriber first gets the item returned by it.
+	 
+		If `isReserved` is true, the subscriber has been counted by a call to reserve() already.
+	 */
+	void add(const rxcpp::subscriber<var>& subscriber, const std::function<var()>& getInitialItem = nullptr, bool isReserved = false);
+	
+	/**
+		Counts a subscriber that's going to be added later, and notifies the count callback. Call add with `isReserved` set to true afterwards.
+	 
+		This lets the count callback run before the caller determines the initial item for the new subscriber.
+	 */
+	void reserve();
+	
+	/** Returns true if the list hasn't been terminated or disposed yet. */
+	bool isActive() const;
+	
+	/** Returns true if there are no subscribers. Doesn't take the lock. */
+	bool isEmpty() const;
+	
+	/** Returns the number of subscribers. Doesn't take the lock. */
+	size_t size() const;
+	
+	/** A function that's called with the new number of subscribers, and a number that increases with each change. */
+	typedef std::function<void(size_t numSubscribers, int64 sequenceNumber)> CountCallback;
+	
+	/**
+		Sets a function that's called with the new number of subscribers whenever it changes. Reserved subscribers are counted, too.
+	 
+		It's called before the initial item is emitted to the new subscriber, so it can still update the initial item. It's called after the list's lock has been released, so calls for concurrent changes may arrive out of order: The callback should ignore a call whose sequence number is lower than the one it has seen last.
+	 */
+	void setCountCallback(const CountCallback& callback);
+	
+	void onNext(const var& next);
+	void onError(Error error);
+	void onCompleted();
+	
+	void dispose();
+	
+	/** Emits the item that has been deferred by a Subject::Transaction, if any. */
+	void emitPendingItem();
+	
+private:
+	struct Entry
+	{
+		int64 id;
+		rxcpp::subscriber<var> subscriber;
+	};
+	typedef std::vector<Entry> Entries;
+	
+	enum class State
+	{
+		Active,
+		Completed,
+		Failed,
+		Disposed
+	};
+	
+	typedef EpochPointer<Entries>::Reader Snapshot;
+	
+	/** A call of the count callback, which has been prepared with the lock held, and is made after releasing it. */
+	struct CountNotification
+	{
+		std::shared_ptr<const CountCallback> callback;
+		size_t numSubscribers;
+		int64 sequenceNumber;
+		
+		void send() const;
+	};
+	
+	EpochPointer<Entries> entries;
+	std::vector<Entries*> reclaimedEntries;
+	CriticalSection writeLock;
+	int64 nextId;
+	size_t numReserved;
+	State state;
+	Error error;
+	const bool defersItems;
+	var pendingItem;
+	bool hasPendingItem;
+	std::shared_ptr<const CountCallback> countCallback;
+	int64 nextCountSequenceNumber;
+	
+	void publish(Entries* newEntries);
+	void deleteReclaimedEntries();
+	CountNotification prepareCountNotification();
+	void emit(const var& next) const;
+	void remove(int64 id);
+	void terminate(State newState, Error newError);
+	
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SubscriberList)
+};
+
+/**
+	Queues the items, new subscribers and terminations of a Subject, and delivers them one at a time without holding any lock. So subscriber code never runs under a lock, and it still sees the events in the order in which they were queued.
+ 
+	If another thread is delivering at the moment, that thread also delivers the new event, and the calling thread returns right away. The same happens if an event is queued from within a subscriber.
+ */
+class SubjectEventQueue
+{
+public:
+	/** Creates a queue for the given list. If the queue serves several lists, pass nullptr, set Event::target and override deliver. */
+	explicit SubjectEventQueue(const std::shared_ptr<SubscriberList>& subscribers);
+	virtual ~SubjectEventQueue() {}
+	
+	void onError(Error error);
+	void onCompleted();
+	void dispose();
+	
+	const std::shared_ptr<SubscriberList> subscribers;
+	
+protected:
+	struct Event
+	{
+		enum class Type
+		{
+			Next,
+			Subscribe,
+			Error,
+			Completed
+		};
+		
+		Type type;
+		var item;
+		std::vector<var> replayedItems;
+		Error error;
+		std::shared_ptr<const rxcpp::subscriber<var>> subscriber;
+		
+		/** The list that the event is for, if the queue serves several lists (e.g. SubjectMap). Otherwise, it's nullptr. */
+		std::shared_ptr<SubscriberList> target;
+	};
+	
+	/** Guards the queue. Subclasses can hold it while they update their own state, so that the state changes in the same order as the events are queued. */
+	CriticalSection queueLock;
+	
+	/** Queues an event. Must be called with the queue lock held. Returns true if the caller should call deliverQueuedEvents after releasing the lock. */
+	bool queue(Event&& event);
+	
+	/** Delivers the queued events, until the queue is empty. */
+	void deliverQueuedEvents();
+	
+	/** Delivers a single event. It's called without holding any lock. */
+	virtual void deliver(const Event& event);
+	
+private:
+	std::vector<Event> events;
+	size_t nextEvent;
+	bool isDelivering;
+	
+	JUCE_DECLARE_NON_COPYABLE(SubjectEventQueue)
 };
 
 class BehaviorSubjectImpl : public Subject::Impl
@@ -27,9 +340,35 @@ public:
 	rxcpp::subscriber<var> getSubscriber() const override;
 	rxcpp::observable<var> asObservable() const override;
 	var getLatestItem() const override;
+	std::shared_ptr<SubscriberList> getSubscriberList() const override;
 	
 private:
-	const rxcpp::subjects::behavior<var> wrapped;
+	/**
+		The latest item is published through an EpochPointer, so getLatestItem doesn't take any lock. onNext writes the item into a recycled slot (with the queue lock held), so it doesn't allocate once enough slots have been reclaimed.
+	 
+		Events are delivered through a SubjectEventQueue. A new subscriber still gets each item exactly once and in order, because its initial item is the latest item at the time it's queued.
+	 */
+	class State : public SubjectEventQueue
+	{
+	public:
+		State(const var& initial);
+		~State();
+		
+		var getLatestItem() const;
+		void onNext(const var& next);
+		void subscribe(const rxcpp::subscriber<var>& subscriber);
+		
+	private:
+		EpochPointer<var> latestItem;
+		std::vector<var*> freeItems;
+		
+		void deliver(const Event& event) override;
+		
+		JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(State)
+	};
+	
+	const rxcpp::composite_subscription lifetime;
+	const std::shared_ptr<State> state;
 	
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BehaviorSubjectImpl)
 };
@@ -41,9 +380,11 @@ public:
 	
 	rxcpp::subscriber<var> getSubscriber() const override;
 	rxcpp::observable<var> asObservable() const override;
+	std::shared_ptr<SubscriberList> getSubscriberList() const override;
 	
 private:
-	const rxcpp::subjects::subject<var> wrapped;
+	const rxcpp::composite_subscription lifetime;
+	const std::shared_ptr<SubscriberList> subscribers;
 	
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PublishSubjectImpl)
 };
@@ -51,15 +392,92 @@ private:
 class ReplaySubjectImpl : public Subject::Impl
 {
 public:
-	ReplaySubjectImpl(size_t bufferSize);
+	ReplaySubjectImpl(size_t bufferSize, double windowMilliseconds);
 	
 	rxcpp::subscriber<var> getSubscriber() const override;
 	rxcpp::observable<var> asObservable() const override;
+	std::shared_ptr<SubscriberList> getSubscriberList() const override;
 	
 private:
-	const rxcpp::subjects::replay<var, rxcpp::identity_one_worker> wrapped;
+	/**
+		The remembered items, in a ring buffer. If the buffer size is limited, the ring buffer is allocated upfront and items are overwritten when it's full. Otherwise, it grows as needed.
+	 
+		The ring buffer is only accessed with the queue lock held. Events are delivered through a SubjectEventQueue, without holding the lock. A new subscriber gets each item exactly once: The items that are in the buffer when it's queued are replayed to it, and later items are delivered after it has been added.
+	 */
+	class Buffer : public SubjectEventQueue
+	{
+	public:
+		Buffer(size_t maxSize, double windowMilliseconds);
+		
+		void onNext(const var& next);
+		void subscribe(const rxcpp::subscriber<var>& subscriber);
+		
+	private:
+		struct Item
+		{
+			var value;
+			double time;
+		};
+		
+		std::vector<Item> items;
+		size_t first;
+		size_t count;
+		const size_t maxSize;
+		const double windowMilliseconds;
+		
+		void removeExpiredItems(double now);
+		void grow();
+		void deliver(const Event& event) override;
+		
+		JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Buffer)
+	};
+	
+	const rxcpp::composite_subscription lifetime;
+	const std::shared_ptr<Buffer> buffer;
 	
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ReplaySubjectImpl)
 };
 
+class ConflatingSubjectImpl : public Subject::Impl
+{
+public:
+	ConflatingSubjectImpl(const std::shared_ptr<Scheduler::Impl>& scheduler);
+	
+	rxcpp::subscriber<var> getSubscriber() const override;
+	rxcpp::observable<var> asObservable() const override;
+	
+private:
+	/**
+		Remembers the latest item until the scheduler runs the next flush. Only the first item of a burst schedules a flush, later items just replace the pending item.
+	 
+		The pending item is taken with the queue lock held, and delivered through the SubjectEventQueue after releasing it. A termination takes the pending item in the same step, so it's still delivered before the termination.
+	 */
+	class State : public SubjectEventQueue, public std::enable_shared_from_this<State>
+	{
+	public:
+		State(const std::shared_ptr<Scheduler::Impl>& scheduler);
+		
+		void onNext(const var& next);
+		void onError(Error error);
+		void onCompleted();
+		void subscribe(const rxcpp::subscriber<var>& subscriber);
+		
+	private:
+		var pendingItem;
+		bool hasPendingItem;
+		const std::shared_ptr<Scheduler::Impl> scheduler;
+		
+		void flush();
+		bool queuePendingItem();
+		void terminate(Event&& event);
+		
+		JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(State)
+	};
+	
+	const rxcpp::composite_subscription lifetime;
+	const std::shared_ptr<State> state;
+	
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ConflatingSubjectImpl)
+};
+
 
@@ -0,0 +1,75 @@
+/*
+  ==============================================================================
+    
+    varx_Derived.cpp
+    Created: 19 Oct 2026 7:22:41pm
+    Author:  Martin Finke
+  
+  ==============================================================================
+*/
+
+Derived::Input::Input(const BehaviorSubject& subject)
+: impl(Derived::sourceFor(subject)) {}
+
+Derived::Input::Input(const Derived& derived)
+: impl(derived.impl) {}
+
+Derived::Input::Input(const Computed& computed)
+: impl(computed.impl) {}
+
+Derived::Derived(std::initializer_list<Input> inputs, const std::function<var(const Array<var>&)>& f)
+: Derived(Array<Input>(inputs), f) {}
+
+Derived::Derived(const Array<Input>& inputs, const std::function<var(const Array<var>&)>& f)
+{
+	std::vector<std::shared_ptr<Impl>> inputNodes;
+	for (auto& input : inputs)
+		inputNodes.push_back(input.impl);
+	
+	impl = Impl::create(inputNodes, [inputNodes, f]() {
+		Array<var> values;
+		values.ensureStorageAllocated(static_cast<int>(inputNodes.size()));
+		
+		for (auto& input : inputNodes)
+			values.add(input->refreshedValue());
+		
+		return f(values);
+	});
+}
+
+std::shared_ptr<Derived::Impl> Derived::sourceFor(const BehaviorSubject& subject)
+{
+	return Impl::forSubject(subject.impl, subject.impl->asObservable(), subject.getLatestItem());
+}
+
+var Derived::getLatestItem() const
+{
+	return impl->getValue();
+}
+
+Observable Derived::asObservable() const
+{
+	return Observable(Observable::Impl::fromRxCpp(impl->asObservable()));
+}
+
+
+Computed::Reader::Reader(Derived::Impl& owner)
+: owner(owner) {}
+
+var Computed::Reader::get(const Derived::Input& input) const
+{
+	return Derived::Impl::read(owner, input.impl, dependencies);
+}
+
+Computed::Computed(const std::function<var(const Reader&)>& f)
+: impl(Derived::Impl::createLazy(f)) {}
+
+var Computed::getLatestItem() const
+{
+	return impl->getValue();
+}
+
+Observable Computed::asObservable() const
+{
+	return Observable(Observable::Impl::fromRxCpp(impl->asObservable()));
+}
@@ -0,0 +1,126 @@
+/*
+  ==============================================================================
+    
+    varx_Derived.h
+    Created: 19 Oct 2026 7:22:41pm
+    Author:  Martin Finke
+  
+  ==============================================================================
+*/
+
+#pragma once
+
+class Computed;
+
+/**
+	A value that is computed from other values (BehaviorSubject​s or other Derived values), and updated automatically when they change. Like a cell in a spreadsheet.
+ 
+	When an input changes, the Derived values that depend on it are recomputed in topological order: Each Derived value is recomputed only after all of its inputs are up to date. So **each Derived value is recomputed at most once per change, and never sees an inconsistent ("glitched") combination of inputs**, even if two of its inputs depend on the same BehaviorSubject:
+ 
+		BehaviorSubject gain(0.5);
+		Derived decibels({gain}, [](Array<var> inputs) { return Decibels::gainToDecibels(double(inputs[0])); });
+		Derived percent({gain}, [](Array<var> inputs) { return double(inputs[0]) * 100; });
+		Derived label({decibels, percent}, [](Array<var> inputs) { return inputs[0].toString() + " dB (" + inputs[1].toString() + "%)"; });
+ 
+		gain.onNext(0.25); // label is recomputed once, with the new decibels AND the new percent
+ 
+	A Derived value emits only if its computed value has changed. The emissions happen after all affected Derived values have been recomputed.
+ */
+class Derived
+{
+	struct Impl;
+	
+public:
+	/** An input of a Derived value: Either a BehaviorSubject, or another Derived value. */
+	class Input
+	{
+	public:
+		/** Creates an Input from a BehaviorSubject. */
+		Input(const BehaviorSubject& subject);
+		
+		/** Creates an Input from another Derived value. */
+		Input(const Derived& derived);
+		
+		/** Creates an Input from a Computed value. */
+		Input(const Computed& computed);
+		
+	private:
+		friend class Derived;
+		friend class Computed;
+		std::shared_ptr<Impl> impl;
+	};
+	
+	/**
+		Creates a Derived value from the given inputs. The function `f` is called with the latest values of the inputs (in the same order), and returns the Derived value.
+	 
+		It's called immediately, and then whenever an input changes. It's called with the lock of the graph of connected values held, so it shouldn't read other Derived or Computed values directly: Make them inputs instead.
+	 */
+	Derived(const juce::Array<Input>& inputs, const std::function<juce::var(const juce::Array<juce::var>&)>& f);
+	/** \overload */
+	Derived(std::initializer_list<Input> inputs, const std::function<juce::var(const juce::Array<juce::var>&)>& f);
+	
+	/** Returns the current value. */
+	juce::var getLatestItem() const;
+	
+	/** Returns an Observable that emits the current value on subscribe, and then whenever the value changes. */
+	Observable asObservable() const;
+	
+private:
+	friend class Computed;
+	std::shared_ptr<Impl> impl;
+	
+	static std::shared_ptr<Impl> sourceFor(const BehaviorSubject& subject);
+	
+	JUCE_LEAK_DETECTOR(Derived)
+};
+
+
+/**
+	A value that is computed lazily from other values (BehaviorSubject​s, Derived or other Computed values), and cached.
+ 
+	Unlike a Derived value, a Computed value doesn't declare its inputs upfront. Instead, its function reads them through a Reader, which tracks them as dependencies. The dependencies can change each time the function is called:
+ 
+		BehaviorSubject useDecibels(false), gain(0.5);
+		Computed label([=](const Computed::Reader& reader) {
+			const double gainValue = reader.get(gain);
+			return (reader.get(useDecibels) ? String(Decibels::gainToDecibels(gainValue)) + " dB" : String(gainValue));
+		});
+ 
+	**The function isn't called until the value is read.** When a dependency changes, the cached value is just marked as outdated, and it's recomputed the next time getLatestItem() is called. So a Computed value that nobody reads costs (almost) nothing.
+ 
+	Once the Computed value is observed (i.e. it has a subscriber, or an observed value depends on it), it's recomputed whenever a dependency changes, so that it can emit. Propagation is glitch-free, just like for Derived values.
+ */
+class Computed
+{
+public:
+	/** Passed to the function of a Computed value, to read its dependencies. */
+	class Reader
+	{
+	public:
+		/** Returns the current value of the given input, and makes it a dependency of the Computed value. */
+		juce::var get(const Derived::Input& input) const;
+		
+	private:
+		friend struct Derived::Impl;
+		explicit Reader(Derived::Impl& owner);
+		Derived::Impl& owner;
+		mutable std::vector<std::shared_ptr<Derived::Impl>> dependencies;
+		
+		JUCE_DECLARE_NON_COPYABLE(Reader)
+	};
+	
+	/** Creates a Computed value with the given function. The function isn't called until the value is read. */
+	explicit Computed(const std::function<juce::var(const Reader&)>& f);
+	
+	/** Returns the current value. Calls the function if a dependency has changed since the last call. */
+	juce::var getLatestItem() const;
+	
+	/** Returns an Observable that emits the current value on subscribe, and then whenever the value changes. */
+	Observable asObservable() const;
+	
+private:
+	friend class Derived;
+	std::shared_ptr<Derived::Impl> impl;
+	
+	JUCE_LEAK_DETECTOR(Computed)
+};
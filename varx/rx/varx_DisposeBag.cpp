@@ -13,12 +13,17 @@ DisposeBag::DisposeBag()
 
 DisposeBag::~DisposeBag()
 {
-	impl->wrapped.unsubscribe();
+	impl->dispose();
 }
 
 void DisposeBag::insert(const Disposable& disposable)
 {
-	impl->wrapped.add(disposable.impl->wrapped);
+	impl->insert(disposable.impl->wrapped);
+}
+
+size_t DisposeBag::size() const
+{
+	return impl->size();
 }
 
 
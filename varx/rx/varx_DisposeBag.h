@@ -14,6 +14,8 @@ class Disposable;
 
 /**
 	Disposes added Disposable​s when it is destroyed.
+ 
+	A Disposable is removed from the DisposeBag as soon as its subscription ends by itself (e.g. because the Observable has completed), so a long-lived DisposeBag doesn't accumulate finished subscriptions.
  */
 class DisposeBag {
 public:
@@ -26,6 +28,9 @@ public:
 	/** Inserts a Disposable into the DisposeBag. The Disposable is disposed when the DisposeBag is destroyed. */
 	void insert(const Disposable& disposable);
 	
+	/** Returns the number of Disposable​s in the DisposeBag whose subscriptions haven't ended yet. */
+	size_t size() const;
+	
 private:
 	struct Impl;
 	const std::shared_ptr<Impl> impl;
@@ -15,6 +15,106 @@ namespace {
 	{
 		return std::chrono::milliseconds(relativeTime.inMilliseconds());
 	}
+	
+	rxcpp::observable<var> fromIndices(int numItems, const std::function<var(int)>& itemAt, unsigned int chunkSize)
+	{
+		return rxcpp::observable<>::create<var>([numItems, itemAt, chunkSize](rxcpp::subscriber<var> s) {
+			// Only exceptions from itemAt are turned into onError. Exceptions from the subscriber propagate to the caller.
+			const auto getItem = [&itemAt, &s](int i, var& item) -> bool {
+				try {
+					item = itemAt(i);
+					return true;
+				}
+				catch (...) {
+					s.on_error(std::current_exception());
+					return false;
+				}
+			};
+			
+			if (chunkSize == 0) {
+				for (int i = 0; i < numItems && s.is_subscribed(); ++i) {
+					var item;
+					if (!getItem(i, item))
+						return;
+					
+					s.on_next(item);
+				}
+			}
+			else {
+				for (int start = 0; start < numItems && s.is_subscribed();) {
+					const int end = start + static_cast<int>(jmin<unsigned int>(chunkSize, numItems - start));
+					
+					Array<var> chunk;
+					chunk.ensureStorageAllocated(end - start);
+					for (int i = start; i < end; ++i) {
+						var item;
+						if (!getItem(i, item))
+							return;
+						
+						chunk.add(item);
+					}
+					
+					s.on_next(chunk);
+					start = end;
+				}
+			}
+			
+			s.on_completed();
+		});
+	}
+	
+	rxcpp::observable<var> fromFile(const File& file, const String& delimiter, bool trimCarriageReturns, unsigned int chunkSize)
+	{
+		jassert(delimiter.isNotEmpty());
+		
+		return rxcpp::observable<>::create<var>([file, delimiter, trimCarriageReturns, chunkSize](rxcpp::subscriber<var> s) {
+			MemoryMappedFile mappedFile(file, MemoryMappedFile::readOnly);
+			const char* const data = static_cast<const char*>(mappedFile.getData());
+			
+			if (!file.existsAsFile() || (data == nullptr && file.getSize() > 0)) {
+				s.on_error(std::make_exception_ptr(std::runtime_error(("Can't read file: " + file.getFullPathName()).toStdString())));
+				return;
+			}
+			
+			const std::string separator = delimiter.toStdString();
+			const char* const end = data + mappedFile.getSize();
+			Array<var> chunk;
+			
+			for (const char* position = data; position < end && s.is_subscribed();) {
+				const char* const recordEnd = std::search(position, end, separator.begin(), separator.end());
+				const char* textEnd = recordEnd;
+				
+				if (trimCarriageReturns && textEnd > position && *(textEnd - 1) == '\r')
+					--textEnd;
+				
+				// String can't hold more than INT_MAX bytes
+				if (textEnd - position > std::numeric_limits<int>::max()) {
+					s.on_error(std::make_exception_ptr(std::runtime_error(("Record is too large: " + file.getFullPathName()).toStdString())));
+					return;
+				}
+				
+				const var record(String::fromUTF8(position, static_cast<int>(textEnd - position)));
+				
+				if (chunkSize == 0)
+					s.on_next(record);
+				else {
+					chunk.add(record);
+					
+					if (chunk.size() == static_cast<int>(chunkSize)) {
+						s.on_next(chunk);
+						chunk.clearQuick();
+					}
+				}
+				
+				position = (recordEnd == end ? end : recordEnd + separator.size());
+			}
+			
+			if (!chunk.isEmpty() && s.is_subscribed())
+				s.on_next(chunk);
+			
+			s.on_completed();
+		});
+	}
 }
 
 
@@ -31,6 +131,36 @@ const std::function<void()> Observable::EmptyOnCompleted = [](){};
 Observable::Observable(const shared_ptr<Impl>& impl)
 :	impl(impl) {}
 
+Observable Observable::animationFrames()
+{
+	return Impl::fromRxCpp(rxcpp::observable<>::create<var>([](rxcpp::subscriber<var> s) {
+		struct Animation : public TickClock::Listener
+		{
+			Animation(const rxcpp::subscriber<var>& subscriber)
+			: subscriber(subscriber),
+			  startTime(TickClock::getCurrentTime()) {}
+			
+			void newTick(double tickTime) override
+			{
+				// Unsubscribing from within on_next destroys this Animation
+				const auto s = subscriber;
+				s.on_next(jmax(0.0, tickTime - startTime));
+			}
+			
+			const rxcpp::subscriber<var> subscriber;
+			const double startTime;
+		};
+		const auto animation = std::make_shared<Animation>(s);
+		
+		TickClock::getInstance()->addListener(animation.get());
+		s.add([animation]() {
+			// Doesn't recreate the clock if this is unsubscribed after shutdown
+			if (auto clock = TickClock::getInstanceWithoutCreating())
+				clock->removeListener(animation.get());
+		});
+	}));
+}
+
 Observable Observable::create(const std::function<void(Observer)>& onSubscribe)
 {
 	return Impl::fromRxCpp(rxcpp::observable<>::create<var>([onSubscribe](rxcpp::subscriber<var> s) {
@@ -57,7 +187,17 @@ Observable Observable::error(const std::exception& error)
 
 Observable Observable::from(const Array<var>& array)
 {
-	return Impl::fromRxCpp(rxcpp::observable<>::iterate(array, rxcpp::identity_immediate()));
+	return iterate(std::make_shared<const Array<var>>(array));
+}
+
+Observable Observable::fromFileLines(const File& file, unsigned int chunkSize)
+{
+	return Impl::fromRxCpp(fromFile(file, "\n", true, chunkSize));
+}
+
+Observable Observable::fromFileRecords(const File& file, const String& delimiter, unsigned int chunkSize)
+{
+	return Impl::fromRxCpp(fromFile(file, delimiter, false, chunkSize));
 }
 
 Observable Observable::fromValue(Value value)
@@ -65,12 +205,24 @@ Observable Observable::fromValue(Value value)
 	return Impl::fromValue(value);
 }
 
+Observable Observable::generate(int numItems, const std::function<var(int)>& generator, unsigned int chunkSize)
+{
+	return Impl::fromRxCpp(fromIndices(numItems, generator, chunkSize));
+}
+
 Observable Observable::interval(const juce::RelativeTime& period)
 {
 	auto o = rxcpp::observable<>::interval(durationFromRelativeTime(period));
 	return Impl::fromRxCpp(o.map(toVar<int>));
 }
 
+Observable Observable::iterate(const std::shared_ptr<const Array<var>>& array, unsigned int chunkSize)
+{
+	jassert(array != nullptr);
+	
+	return Impl::fromRxCpp(fromIndices(array->size(), [array](int i) { return array->getReference(i); }, chunkSize));
+}
+
 Observable Observable::just(const var& value)
 {
 	return Impl::fromRxCpp(rxcpp::observable<>::just(value));
@@ -140,6 +292,45 @@ Disposable Observable::subscribe(const Observer& observer) const
 
 #pragma mark - Operators
 
+Observable Observable::batched() const
+{
+	const rxcpp::observable<var> source = impl->wrapped;
+	
+	return Impl::fromRxCpp(rxcpp::observable<>::create<var>([source](rxcpp::subscriber<var> s) {
+		struct State
+		{
+			var latestItem;
+			bool isFlushScheduled = false;
+		};
+		const auto state = std::make_shared<State>();
+		
+		source.subscribe(s.get_subscription(), [s, state](const var& next) {
+			const auto transaction = Subject::Transaction::Impl::getCurrent();
+			
+			if (transaction == nullptr || !transaction->isCommitting()) {
+				s.on_next(next);
+				return;
+			}
+			
+			state->latestItem = next;
+			
+			if (!state->isFlushScheduled) {
+				state->isFlushScheduled = true;
+				transaction->addBatchedFlush([s, state]() {
+					const var item = state->latestItem;
+					state->latestItem = var();
+					state->isFlushScheduled = false;
+					s.on_next(item);
+				});
+			}
+		}, [s](Error error) {
+			s.on_error(error);
+		}, [s]() {
+			s.on_completed();
+		});
+	}));
+}
+
 Observable Observable::combineLatest(Observable o1, Function2& f) const
 {
 	return impl->combineLatest(f, o1);
@@ -198,6 +389,11 @@ Observable Observable::concat(Observable o1, Observable o2, Observable o3, Obser
 	return impl->concat(o1, o2, o3, o4, o5, o6, o7);
 }
 
+Observable Observable::concatMap(const std::function<Observable(const var&)>& f) const
+{
+	return flatMap(f, 1);
+}
+
 Observable Observable::debounce(const juce::RelativeTime& period) const
 {
 	return Impl::fromRxCpp(impl->wrapped.debounce(durationFromRelativeTime(period)));
@@ -225,6 +421,20 @@ Observable Observable::flatMap(const std::function<Observable(const var&)>& f) c
 	}));
 }
 
+Observable Observable::flatMap(const std::function<Observable(const var&)>& f, unsigned int maxConcurrent) const
+{
+	jassert(maxConcurrent > 0);
+	
+	return impl->flatMap([f](const var& value) {
+		return f(value).impl->wrapped;
+	}, maxConcurrent);
+}
+
+Observable Observable::groupBy(Function1 keySelector) const
+{
+	return impl->groupBy(keySelector);
+}
+
 Observable Observable::map(Function1 f) const
 {
 	return Impl::fromRxCpp(impl->wrapped.map(f));
@@ -259,6 +469,14 @@ Observable Observable::merge(Observable o1, Observable o2, Observable o3, Observ
 	return impl->merge(o1, o2, o3, o4, o5, o6, o7);
 }
 
+Observable Observable::parallelMap(Function1 f, unsigned int maxConcurrency, bool preserveOrder) const
+{
+	if (maxConcurrency == 0)
+		maxConcurrency = SystemStats::getNumCpus();
+	
+	return impl->parallelMap(f, maxConcurrency, preserveOrder);
+}
+
 Observable Observable::reduce(const var& startValue, Function2 f) const
 {
 	return Impl::fromRxCpp(impl->wrapped.reduce(startValue, f));
@@ -269,6 +487,52 @@ Observable Observable::sample(const juce::RelativeTime& interval)
 	return Impl::fromRxCpp(impl->wrapped.sample_with_time(durationFromRelativeTime(interval)));
 }
 
+Observable Observable::sampleOnFrame() const
+{
+	const rxcpp::observable<var> source = impl->wrapped;
+	
+	return Impl::fromRxCpp(rxcpp::observable<>::create<var>([source](rxcpp::subscriber<var> s) {
+		struct State
+		{
+			CriticalSection lock;
+			var latestItem;
+			bool isFlushScheduled = false;
+		};
+		const auto state = std::make_shared<State>();
+		
+		source.subscribe(s.get_subscription(), [s, state](const var& next) {
+			const ScopedLock sl(state->lock);
+			state->latestItem = next;
+			
+			if (!state->isFlushScheduled) {
+				state->isFlushScheduled = true;
+				TickClock::getInstance()->callOnNextTick([s, state]() {
+					var item;
+					
+					{
+						const ScopedLock sl(state->lock);
+						item = state->latestItem;
+						state->latestItem = var();
+						state->isFlushScheduled = false;
+					}
+					
+					if (s.is_subscribed())
+						s.on_next(item);
+				});
+			}
+		}, [s](Error error) {
+			// Called after a pending item has been emitted
+			TickClock::getInstance()->callOnNextTick([s, error]() {
+				s.on_error(error);
+			});
+		}, [s]() {
+			TickClock::getInstance()->callOnNextTick([s]() {
+				s.on_completed();
+			});
+		});
+	}));
+}
+
 Observable Observable::scan(const var& startValue, Function2 f) const
 {
 	return Impl::fromRxCpp(impl->wrapped.scan(startValue, f));
@@ -326,6 +590,13 @@ Observable Observable::switchOnNext() const
 	return Impl::fromRxCpp(unwrapped.switch_on_next());
 }
 
+Observable Observable::switchMap(const std::function<Observable(const var&)>& f) const
+{
+	return Impl::fromRxCpp(impl->wrapped.map([f](const var& value) {
+		return f(value).impl->wrapped;
+	}).switch_on_next());
+}
+
 Observable Observable::take(unsigned int numItems) const
 {
 	return Impl::fromRxCpp(impl->wrapped.take(numItems));
@@ -346,6 +617,55 @@ Observable Observable::takeWhile(const std::function<bool(const var&)>& predicat
 	return Impl::fromRxCpp(impl->wrapped.take_while(predicate));
 }
 
+Observable Observable::tweenTo(double target, const juce::RelativeTime& duration, const Easing& easing) const
+{
+	return tween(target, duration, easing, [target](const var& from) {
+		const double start = from;
+		return [start, target](double proportion) {
+			return var(start + (target - start) * proportion);
+		};
+	});
+}
+
+Observable Observable::tweenTo(const juce::Colour& target, const juce::RelativeTime& duration, const Easing& easing) const
+{
+	return tween(toVar(target), duration, easing, [target](const var& from) {
+		// Unwraps the start colour once per animation. Wrapping a Colour allocates, so the last item is reused while the interpolated ARGB value doesn't change.
+		const Colour start = fromVar<Colour>(from);
+		uint32 lastARGB = start.getARGB();
+		var lastItem = from;
+		
+		return [start, target, lastARGB, lastItem](double proportion) mutable {
+			const Colour colour = start.interpolatedWith(target, static_cast<float>(proportion));
+			
+			if (colour.getARGB() != lastARGB) {
+				lastARGB = colour.getARGB();
+				lastItem = toVar(colour);
+			}
+			
+			return lastItem;
+		};
+	});
+}
+
+Observable Observable::tween(const var& target, const juce::RelativeTime& duration, const Easing& easing, const std::function<std::function<var(double)>(const var&)>& makeInterpolator) const
+{
+	const double durationInSeconds = duration.inSeconds();
+	
+	return switchMap([target, durationInSeconds, easing, makeInterpolator](const var& from) {
+		const auto interpolate = makeInterpolator(from);
+		
+		return animationFrames()
+			.takeWhile([durationInSeconds](const var& elapsed) {
+				return static_cast<double>(elapsed) < durationInSeconds;
+			})
+			.map([durationInSeconds, easing, interpolate](const var& elapsed) {
+				return interpolate(easing(static_cast<double>(elapsed) / durationInSeconds));
+			})
+			.concat(Observable::just(target));
+	});
+}
+
 Observable Observable::withLatestFrom(Observable o1, Function2& f) const
 {
 	return impl->withLatestFrom(f, o1);
@@ -25,6 +25,15 @@ public:
 	//! @endcond
 	
 #pragma mark - Creation
+	/**
+		Returns an Observable that emits with every tick of the TickClock (a shared 60 Hz timer, not synchronised with the display), on the message thread. The emitted items are the number of seconds (as `double`) since the time of subscription.
+	 
+		All animations share the timer of the TickClock, so they are advanced together. Emitting an item doesn't allocate. The Observable emits endlessly, until you unsubscribe.
+	 
+		@see Observable::tweenTo
+	 */
+	static Observable animationFrames();
+	
 	/**
 		Creates an Observable which emits values from an Observer on each subscription.
 	 
@@ -55,18 +64,56 @@ public:
 			Observable::from({"Hello", "Test"})
 	 
 			Observable::from({var(3), var("four")})
+	 
+		The Array is copied once, and the copy is shared between all subscriptions. To avoid the copy for large collections, use Observable::iterate.
 	 */
 	static Observable from(const juce::Array<var>& array);
 	
+	/**
+		Creates an Observable that emits the lines of a text file as Strings, and completes after the last line. The file is expected to be UTF-8 encoded.
+	 
+		The file is memory-mapped and the lines are read lazily on each subscription, so even very large files are streamed with constant memory. Lines can be separated by `"\n"` or `"\r\n"`; the line separators are not included in the emitted Strings.
+	 
+		If `chunkSize` is greater than zero, the returned Observable emits Arrays of up to `chunkSize` lines instead of the single lines.
+	 
+		If the file doesn't exist or can't be read, the returned Observable notifies onError.
+	 */
+	static Observable fromFileLines(const juce::File& file, unsigned int chunkSize = 0);
+	
+	/**
+		Like Observable::fromFileLines, but splits the file at each occurrence of a given `delimiter`, instead of at line separators.
+	 
+		For example:
+	 
+			Observable::fromFileRecords(file, ";") // "a;b;c" => {"a", "b", "c"}
+	 */
+	static Observable fromFileRecords(const juce::File& file, const juce::String& delimiter, unsigned int chunkSize = 0);
+	
 	/**
 		Creates an Observable from a given JUCE Value. The returned Observable **only emits items until it is destroyed**, so you are responsible for managing its lifetime. Or use Reactive<Value>, which will handle this.
 	 
 		The returned Observable notifies the onComplete handler when it's destroyed. @see Observable::subscribe
 	 
 		When calling Value::setValue, it notifies asynchronously. So **the returned Observable emits the new value asynchronously.** If you call setValue immediately before destroying the returned Observable, the new value will not be emitted.
+	 
+		If the Value refers to a SynchronousValueSource, the returned Observable emits the new value synchronously instead, before Value::setValue returns.
 	 */
 	static Observable fromValue(juce::Value value);
 	
+	/**
+		Creates an Observable which calls `generator` with the indices `0` to `numItems - 1` on each subscription, and emits the returned items. It completes after emitting the last item.
+	 
+		The items are created lazily, one at a time. If the subscriber unsubscribes early (e.g. because of Observable::take), the remaining items are not created at all.
+	 
+		If `chunkSize` is greater than zero, the returned Observable emits Arrays of up to `chunkSize` items instead of the single items. This reduces the per-item overhead for large numbers of items.
+	 
+		For example:
+	 
+			Observable::generate(4, [](int i) { return i * i; }) // {0, 1, 4, 9}
+			Observable::generate(5, [](int i) { return i; }, 2) // {[0, 1], [2, 3], [4]}
+	 */
+	static Observable generate(int numItems, const std::function<var(int)>& generator, unsigned int chunkSize = 0);
+	
 	/**
 		Returns an Observable that emits one item every `interval`, starting at the time of subscription (where the first item is emitted). The emitted items are `1`, `2`, `3`, and so on.
 	 
@@ -76,6 +123,15 @@ public:
 	 */
 	static Observable interval(const juce::RelativeTime& interval);
 	
+	/**
+		Creates an Observable that emits the items from a shared, immutable Array. It completes after emitting the last item.
+	 
+		Unlike Observable::from, the Array is **not copied**: The returned Observable (and each of its subscriptions) just keeps a reference to it. Use this for large collections, to avoid duplicating them in memory.
+	 
+		If `chunkSize` is greater than zero, the returned Observable emits Arrays of up to `chunkSize` items instead of the single items. @see Observable::generate
+	 */
+	static Observable iterate(const std::shared_ptr<const juce::Array<var>>& array, unsigned int chunkSize = 0);
+	
 	/**
 		Creates an Observable which emits a single item.
 	 
@@ -162,6 +218,17 @@ public:
 	///@}
 	
 #pragma mark - Operators
+	/**
+		Returns an Observable that emits the items from this Observable, but at most once per Subject::Transaction.
+	 
+		While a transaction is being committed, the items from this Observable are collapsed into the latest one. It's emitted after all affected Subjects have emitted their new items. Outside of a commit, the items are emitted immediately.
+	 
+		Use this at the end of a pipeline that combines multiple Subjects (e.g. with Observable::combineLatest), so that it emits just once per transaction, with a consistent state.
+	 
+		@see Subject::Transaction
+	 */
+	Observable batched() const;
+	
 	///@{
 	/**
 		Returns an Observable that emits **whenever** an item is emitted by either this Observable **or** o1, o2, …. It combines the **latest** item from each Observable via the given function and emits the result of this function.
@@ -206,6 +273,15 @@ public:
 	Observable concat(Observable o1, Observable o2, Observable o3, Observable o4, Observable o5, Observable o6, Observable o7) const;
 	///@}
 	
+	/**
+		For each emitted item, calls `f` and emits the items from the Observable returned from `f`. Only subscribes to the next returned Observable when the previous one has completed, so the items are not interleaved.
+	 
+		This is the same as calling Observable::flatMap with `maxConcurrent` set to 1.
+	 
+		@see Observable::flatMap, Observable::switchMap.
+	 */
+	Observable concatMap(const std::function<Observable(const var&)>& f) const;
+	
 	/**
 		Returns an Observable which emits if `interval` has passed without this Observable emitting an item. The returned Observable emits the latest item from this Observable.
 	 
@@ -241,10 +317,36 @@ public:
 	 
 		Will emit the items: `"hello"`, `"HELLO!"`, `"world"` and `"WORLD!"`.
 	 
-		@see Observable::merge, Observable::switchOnNext.
+		@see Observable::merge, Observable::concatMap, Observable::switchMap.
 	 */
 	Observable flatMap(const std::function<Observable(const var&)>& f) const;
 	
+	/**
+		Like Observable::flatMap, but subscribes to at most `maxConcurrent` of the Observables returned from `f` at the same time.
+	 
+		If this Observable emits an item while `maxConcurrent` returned Observables are still active, `f` is not called until one of them completes. So if 500 items arrive at once and `f` starts loading a file, only `maxConcurrent` files are loaded at the same time.
+	 
+		`maxConcurrent` must be greater than 0.
+	 */
+	Observable flatMap(const std::function<Observable(const var&)>& f, unsigned int maxConcurrent) const;
+	
+	/**
+		Divides this Observable into groups of items that have the same key. The key of an item is the value returned by calling `keySelector` with the item.
+	 
+		Whenever an item with a new key is emitted, the returned Observable emits an Array with two items: The key, and an Observable which emits all items with this key. The first item with the new key is emitted by the group Observable right after the Array has been emitted.
+	 
+		The groups are looked up in a hash map, so routing an item to its group takes constant time regardless of the number of keys. For example, to handle parameter changes for each parameter separately:
+	 
+			parameterChanges.groupBy([](var change) { return change["id"]; }).subscribe([](Array<var> group) {
+				String parameterID = group[0];
+				Observable changesForParameter = fromVar<Observable>(group[1]);
+				// Subscribe to changesForParameter…
+			});
+	 
+		The group Observables complete (or notify onError) when this Observable completes (or notifies onError).
+	 */
+	Observable groupBy(Function1 keySelector) const;
+	
 	/**
 		For each item emitted by this Observable, call the function with that item and emit the result.
 	 
@@ -273,6 +375,19 @@ public:
 	Observable merge(Observable o1, Observable o2, Observable o3, Observable o4, Observable o5, Observable o6, Observable o7) const;
 	///@}
 	
+	/**
+		Like Observable::map, but calls `f` for multiple items at the same time, on a thread pool that's shared between Observables. This is useful for CPU-heavy transformations, such as rendering waveforms or generating thumbnails.
+	 
+		At most `maxConcurrency` items are processed at the same time. If you pass 0, it uses one thread per CPU core. Items that arrive while all threads are busy are queued until a thread becomes available.
+	 
+		**The queue isn't bounded.** If this Observable emits items faster than `f` can process them, the queue keeps growing. To drop items instead, reduce the rate before calling this, e.g. with Observable::sample or Observable::sampleOnFrame.
+	 
+		If `preserveOrder` is true, the results are emitted in the same order as the items emitted by this Observable. A result that is ready early is held back until the results for all previous items have been emitted. If `preserveOrder` is false, each result is emitted as soon as it's ready.
+	 
+		​ **`f` is called on multiple threads at the same time**, so it must be thread-safe. The returned Observable emits items on the pool threads. You can use Observable::observeOn to process them on a different thread.
+	 */
+	Observable parallelMap(Function1 f, unsigned int maxConcurrency = 0, bool preserveOrder = true) const;
+	
 	/**
 		Begins with a `startValue`, and then applies `f` to all items emitted by this Observable, and returns the aggregate result as a single-element Observable sequence.
 	 */
@@ -287,6 +402,15 @@ public:
 	 */
 	Observable sample(const juce::RelativeTime& interval);
 	
+	/**
+		Returns an Observable which checks with every tick of the TickClock (a shared 60 Hz timer, not synchronised with the display) whether this Observable has emitted any new items. If so, the returned Observable emits the latest item from this Observable on the message thread.
+	 
+		Unlike Observable::sample, this doesn't start a timer for each subscription. All Observables returned from sampleOnFrame share the TickClock, so all GUI components that are bound to them are updated together, once per tick.
+	 
+		@see Scheduler::frame
+	 */
+	Observable sampleOnFrame() const;
+	
 	/**
 		Calls a function `f` with the given `startValue` and the first item emitted by this Observable. The value returned from `f` is remembered. When the second item is emitted, `f` is called with the remembered value (called the *accumulator*) and the second emitted item. The returned item is remembered, until the third item is emitted, and so on.
 		
@@ -330,6 +454,15 @@ public:
 	 */
 	Observable switchOnNext() const;
 	
+	/**
+		For each emitted item, calls `f` and emits the items from the Observable returned from `f`, until this Observable emits the next item. Then it unsubscribes from the previously returned Observable and continues with the new one.
+	 
+		This is the same as calling Observable::map and then Observable::switchOnNext, but it doesn't need to wrap each returned Observable into a var.
+	 
+		@see Observable::flatMap, Observable::concatMap.
+	 */
+	Observable switchMap(const std::function<Observable(const var&)>& f) const;
+	
 	/**
 		Returns an Observable that emits only the first `numItems` items from this Observable.
 	 */
@@ -352,6 +485,22 @@ public:
 	 */
 	Observable takeWhile(const std::function<bool(const var&)>& predicate) const;
 	
+	///@{
+	/**
+		For each item emitted by this Observable, animates from that item to `target` within `duration`. The returned Observable emits the animated value with every tick of the TickClock (see Observable::animationFrames), and emits `target` when the animation is finished. If this Observable emits a new item during an animation, the animation is cancelled and a new one starts from the new item.
+	 
+		This Observable must emit `double`s (for the first overload) or Colours wrapped with toVar (for the second overload). The emitted items have the same type.
+	 
+		For example, to fade a Label's text colour in:
+	 
+			Observable::just(toVar(Colours::transparentBlack))
+				.tweenTo(Colours::black, RelativeTime::seconds(0.3), Easing::easeOut())
+				.subscribe(label.rx.colour(Label::textColourId));
+	 */
+	Observable tweenTo(double target, const juce::RelativeTime& duration, const Easing& easing = Easing::linear()) const;
+	Observable tweenTo(const juce::Colour& target, const juce::RelativeTime& duration, const Easing& easing = Easing::linear()) const;
+	///@}
+	
 	///@{
 	/**
 		Returns an Observable that emits whenever an item is emitted by this Observable. It combines the latest item from each Observable via the given function and emits the result of this function.
@@ -436,10 +585,14 @@ public:
 	
 private:
 	friend class Subject;
+	friend class SubjectMap;
+	friend class Derived;
 	struct Impl;
 	Observable(const std::shared_ptr<Impl>&);
 	std::shared_ptr<Impl> impl;
 
+	Observable tween(const var& target, const juce::RelativeTime& duration, const Easing& easing, const std::function<std::function<var(double)>(const var&)>& makeInterpolator) const;
+	
 	static var CombineIntoArray2(const var&, const var&);
 	static var CombineIntoArray3(const var&, const var&, const var&);
 	static var CombineIntoArray4(const var&, const var&, const var&, const var&);
@@ -33,7 +33,9 @@ public:
 	
 private:
 	friend class Subject;
+	friend class SubjectMap;
 	friend class Observable;
+	friend class ExtensionBase;
 	struct Impl;
 	explicit Observer(const std::shared_ptr<Impl>& impl);
 	std::shared_ptr<Impl> impl;
@@ -70,6 +70,29 @@ Scheduler Scheduler::messageThread()
 	});
 }
 
+Scheduler Scheduler::frame()
+{
+	return std::make_shared<Scheduler::Impl>([](const rxcpp::observable<juce::var>& source) {
+		return rxcpp::observable<>::create<juce::var>([source](rxcpp::subscriber<juce::var> s) {
+			// The TickClock calls the functions in the order in which they were added, so the items stay in order
+			source.subscribe(s.get_subscription(), [s](const juce::var& next) {
+				TickClock::getInstance()->callOnNextTick([s, next]() {
+					if (s.is_subscribed())
+						s.on_next(next);
+				});
+			}, [s](std::exception_ptr error) {
+				TickClock::getInstance()->callOnNextTick([s, error]() {
+					s.on_error(error);
+				});
+			}, [s]() {
+				TickClock::getInstance()->callOnNextTick([s]() {
+					s.on_completed();
+				});
+			});
+		});
+	});
+}
+
 Scheduler Scheduler::backgroundThread()
 {
 	return std::make_shared<Scheduler::Impl>([](const rxcpp::observable<juce::var>& observable) {
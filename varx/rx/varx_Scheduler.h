@@ -13,7 +13,7 @@
 /**
 	A Scheduler is used to process parts of an Observable on a specific thread.
  
-	Use the Scheduler::messageThread, Scheduler::backgroundThread and Scheduler::newThread member functions and pass the returned Scheduler to Observable::observeOn.
+	Use the Scheduler::messageThread, Scheduler::frame, Scheduler::backgroundThread and Scheduler::newThread member functions and pass the returned Scheduler to Observable::observeOn.
  
 	@see Observable::observeOn
  */
@@ -23,6 +23,9 @@ public:
 	/** The JUCE message thread. */
 	static Scheduler messageThread();
 	
+	/** The JUCE message thread, in sync with the ticks of the TickClock (a shared 60 Hz timer, not synchronised with the display). Each item is emitted with the next tick, together with the items of all other Observables that use this Scheduler. No items are dropped; use Observable::sampleOnFrame if you only need the latest item per tick. */
+	static Scheduler frame();
+	
 	/** A shared background thread. Use this if you don't want to block the message thread, but don't want to spawn a new thread either. The thread is shared between Observables. */
 	static Scheduler backgroundThread();
 	
@@ -33,6 +36,7 @@ private:
 	struct Impl;
 	std::shared_ptr<Impl> impl;
 	friend class Observable;
+	friend class ConflatingSubject;
 	Scheduler(const std::shared_ptr<Impl>&);
 	
 	JUCE_LEAK_DETECTOR(Scheduler)
@@ -0,0 +1,60 @@
+/*
+  ==============================================================================
+    
+    varx_SubjectMap.cpp
+    Created: 19 Oct 2026 4:05:12pm
+    Author:  Martin Finke
+  
+  ==============================================================================
+*/
+
+SubjectMap::SubjectMap()
+: impl(std::make_shared<Impl>()) {}
+
+Observable SubjectMap::observe(const Identifier& key) const
+{
+	const std::shared_ptr<Impl> impl = this->impl;
+	
+	return Observable(Observable::Impl::fromRxCpp(rxcpp::observable<>::create<var>([impl, key](rxcpp::subscriber<var> s) {
+		impl->subscribe(key, s);
+	})));
+}
+
+Observer SubjectMap::observer(const Identifier& key) const
+{
+	const std::shared_ptr<Impl> impl = this->impl;
+	
+	return Observer(std::make_shared<Observer::Impl>(rxcpp::make_subscriber<var>(rxcpp::make_observer_dynamic<var>([impl, key](const var& next) {
+		impl->setValue(key, next);
+	}, [](Error) {}, []() {}))));
+}
+
+void SubjectMap::setValue(const Identifier& key, const var& value) const
+{
+	impl->setValue(key, value);
+}
+
+var SubjectMap::getValue(const Identifier& key) const
+{
+	return impl->getValue(key);
+}
+
+bool SubjectMap::contains(const Identifier& key) const
+{
+	return !impl->getValue(key).isUndefined();
+}
+
+int SubjectMap::size() const
+{
+	return impl->size();
+}
+
+NamedValueSet SubjectMap::getValues() const
+{
+	return impl->getValues();
+}
+
+void SubjectMap::setValues(const NamedValueSet& values) const
+{
+	impl->setValues(values);
+}
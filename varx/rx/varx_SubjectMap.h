@@ -0,0 +1,64 @@
+/*
+  ==============================================================================
+    
+    varx_SubjectMap.h
+    Created: 19 Oct 2026 4:05:12pm
+    Author:  Martin Finke
+  
+  ==============================================================================
+*/
+
+#pragma once
+
+/**
+	Stores the latest values for a large number of keys, and lets you observe each key individually.
+ 
+	It's like having a BehaviorSubject per key, but much cheaper: The latest values are stored in a flat table, and a key is only routed to its own subscribers. So setting a value doesn't cost more if there are many other keys, or many subscribers of other keys.
+ 
+		SubjectMap parameters;
+		parameters.setValue("gain", 0.5);
+		parameters.observe("gain").subscribe([](var gain) { ... }); // Emits 0.5
+		parameters.setValue("gain", 0.7); // Emits 0.7
+ 
+	Setting a value that is equal to the current value (and has the same type) doesn't emit anything.
+ */
+class SubjectMap
+{
+public:
+	/** Creates a new, empty SubjectMap. */
+	SubjectMap();
+	
+	/**
+		Returns an Observable that emits the value for the given key whenever it changes.
+	 
+		If the key already has a value, it's emitted immediately on subscribe (like with a BehaviorSubject). The Observable never completes.
+	 */
+	Observable observe(const juce::Identifier& key) const;
+	
+	/** Returns an Observer which sets the value for the given key when you call Observer::onNext. onError and onCompleted are ignored. */
+	Observer observer(const juce::Identifier& key) const;
+	
+	/** Sets the value for the given key, and emits it to the subscribers of that key. */
+	void setValue(const juce::Identifier& key, const juce::var& value) const;
+	
+	/** Returns the latest value for the given key, or an undefined var if it has no value. */
+	juce::var getValue(const juce::Identifier& key) const;
+	
+	/** Returns true if the given key has a value. */
+	bool contains(const juce::Identifier& key) const;
+	
+	/** Returns the number of keys that have a value. */
+	int size() const;
+	
+	/** Returns a snapshot of all keys and their latest values. */
+	juce::NamedValueSet getValues() const;
+	
+	/** Sets the values for all keys in the given set. Each changed value is emitted to the subscribers of its key. */
+	void setValues(const juce::NamedValueSet& values) const;
+	
+private:
+	struct Impl;
+	std::shared_ptr<Impl> impl;
+	
+	JUCE_LEAK_DETECTOR(SubjectMap)
+};
@@ -23,6 +23,24 @@ Observer Subject::asObserver() const
 	return *this;
 }
 
+Subject::Transaction::Transaction()
+: impl(std::make_shared<Impl>()) {}
+
+Subject::Transaction::~Transaction()
+{
+	try {
+		impl->commit();
+	}
+	catch (...) {
+		jassertfalse;
+	}
+}
+
+void Subject::Transaction::commit()
+{
+	impl->commit();
+}
+
 BehaviorSubject::BehaviorSubject(const juce::var& initial)
 : Subject(std::make_shared<BehaviorSubjectImpl>(initial)) {}
 
@@ -31,11 +49,17 @@ var BehaviorSubject::getLatestItem() const
 	return impl->getLatestItem();
 }
 
+ConflatingSubject::ConflatingSubject(const Scheduler& scheduler)
+: Subject(std::make_shared<ConflatingSubjectImpl>(scheduler.impl)) {}
+
 PublishSubject::PublishSubject()
 : Subject(std::make_shared<PublishSubjectImpl>()) {}
 
 ReplaySubject::ReplaySubject(size_t bufferSize)
-: Subject(std::make_shared<ReplaySubjectImpl>(bufferSize)) {}
+: Subject(std::make_shared<ReplaySubjectImpl>(bufferSize, std::numeric_limits<double>::infinity())) {}
+
+ReplaySubject::ReplaySubject(size_t bufferSize, const juce::RelativeTime& windowDuration)
+: Subject(std::make_shared<ReplaySubjectImpl>(bufferSize, windowDuration.inMilliseconds())) {}
 
 const size_t ReplaySubject::MaxBufferSize = std::numeric_limits<size_t>::max();
 
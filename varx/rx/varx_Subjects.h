@@ -28,14 +28,64 @@ public:
 	 */
 	Observer asObserver() const;
 	
+	/**
+		Defers the notifications of all Subjects until the transaction is committed.
+	 
+		Use this when you change several related Subjects at once, so that the pipelines which depend on them don't see intermediate, inconsistent states:
+	 
+			Observable range = minimum.combineLatest(maximum).batched();
+	 
+			{
+				Subject::Transaction transaction;
+				minimum.onNext(10);
+				maximum.onNext(20);
+			} // range emits [10, 20] once, here
+	 
+		Only BehaviorSubjects are deferred. Items of a PublishSubject are events, and a ReplaySubject replays every item, so they're emitted immediately.
+	 
+		While the transaction is open, calling onNext on a Subject changes its latest item (e.g. BehaviorSubject::getLatestItem), but doesn't emit it yet. If onNext is called multiple times on the same Subject, only the latest item is emitted. When the transaction is committed, each affected Subject emits once. After that, each Observable::batched emits once, with its latest item.
+	 
+		A transaction applies to all Subjects that receive items on the thread which created it. It must be committed (or destroyed) on that same thread. If a transaction is created while another one is open on the same thread, it joins the outer one: Its commit does nothing, and the items are emitted when the outer transaction is committed.
+	 
+		@see Observable::batched
+	 */
+	class Transaction
+	{
+	public:
+		/** Opens a new transaction on the calling thread. */
+		Transaction();
+		
+		/**
+			Commits the transaction, if it hasn't been committed yet.
+		 
+			If a subscriber throws while the transaction is committed here, the exception is swallowed (and a debug assertion fails). If your subscribers can throw, call commit() explicitly to get the exception.
+		 */
+		~Transaction();
+		
+		/** Emits the deferred items. After calling this, items are emitted immediately again. If a subscriber throws, the remaining items are still emitted, and the first exception is rethrown afterwards. */
+		void commit();
+		
+	private:
+		friend class Observable;
+		friend class SubscriberList;
+		struct Impl;
+		const std::shared_ptr<Impl> impl;
+		
+		JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Transaction)
+	};
+	
 private:
 	friend class BehaviorSubject;
 	friend class BehaviorSubjectImpl;
+	friend class ConflatingSubject;
+	friend class ConflatingSubjectImpl;
 	friend class PublishSubject;
 	friend class PublishSubjectImpl;
 	friend class ReplaySubject;
 	friend class ReplaySubjectImpl;
 	friend class Observable;
+	friend class Derived;
+	friend class ExtensionBase;
 	struct Impl;
 	explicit Subject(const std::shared_ptr<Impl>& impl);
 	std::shared_ptr<Impl> impl;
@@ -46,6 +96,8 @@ private:
 
 /**
 	A subject that starts with an initial item. On subscribe, it emits the most recently emitted item. It then continues to emit any items that are passed to onNext.
+ 
+	Subscribers are always notified one item at a time and in order, without holding a lock. So onNext doesn't always deliver the item before it returns: If another thread is currently delivering items to the subscribers, or if onNext is called from within a subscriber, the item is queued and delivered by the call that's already delivering. getLatestItem returns the new item right away, though.
  */
 class BehaviorSubject : public Subject
 {
@@ -53,7 +105,7 @@ public:
 	/** Creates a new instance with a given initial item */
 	explicit BehaviorSubject(const juce::var& initial);
 	
-	/** Returns the most recently emitted item. If no items have been emitted, it returns the initial item. */
+	/** Returns the most recently emitted item. If no items have been emitted, it returns the initial item. Can be called from any thread, and doesn't take any lock. */
 	juce::var getLatestItem() const;
 	
 private:
@@ -76,6 +128,8 @@ private:
 
 /**
 	A Subject that, on every new disposable, notifies the Observer with all of the items that were emitted since the ReplaySubject was created. It then continues to emit any items that are passed to onNext.
+ 
+	Like a BehaviorSubject, it notifies its subscribers without holding a lock, one item at a time and in order. So onNext may return before the item is delivered, if another call is delivering at the moment.
  */
 class ReplaySubject : public Subject
 {
@@ -83,17 +137,51 @@ public:
 	/**
 		Creates a new instance.
 	 
-		The `bufferSize` is the maximum number of items to remember and replay. Pass ReplaySubject::MaxBufferSize if you want all items to be remembered. The buffer size is increased as items are emitted (not allocated upfront).
+		The `bufferSize` is the maximum number of items to remember and replay. Pass ReplaySubject::MaxBufferSize if you want all items to be remembered.
+	 
+		A limited buffer is allocated upfront, as a ring buffer. So remembering new items doesn't allocate, and the memory usage doesn't grow over time.
 	 */
 	explicit ReplaySubject(size_t bufferSize = MaxBufferSize);
 	
+	/**
+		Creates a new instance which only remembers items that have been emitted within the last `windowDuration`. Older items are discarded, and not replayed to new subscribers.
+	 
+		The `bufferSize` limits the number of remembered items additionally, as above.
+	 */
+	ReplaySubject(size_t bufferSize, const juce::RelativeTime& windowDuration);
+	
 	/**
 		The maximum number of items that can be remembered by this class. You can pass this to ReplaySubject::ReplaySubject to remember "all" items (within memory boundaries).
 	 
-		The buffer size is increased as items are emitted (not allocated upfront).
+		In this case, the buffer size is increased as items are emitted (not allocated upfront).
 	 */
 	static const size_t MaxBufferSize;
 	
 private:
 	JUCE_LEAK_DETECTOR(ReplaySubject)
 };
+
+
+/**
+	A Subject that collapses bursts of items into the latest item.
+ 
+	When onNext is called, the item isn't emitted immediately. Instead, the ConflatingSubject waits for the next tick of the given Scheduler, and then emits the latest item. So if onNext is called many times in a row (e.g. when loading a preset sets every parameter), the subscribers react only once, to the latest item:
+ 
+		ConflatingSubject subject;
+		for (int i = 0; i < 100; ++i)
+			subject.onNext(i);
+		// On the next tick of the message thread, subject emits 99
+ 
+	When onCompleted or onError is called, a pending item is emitted immediately, before the termination.
+ 
+	Like a PublishSubject, it doesn't emit anything on subscribe.
+ */
+class ConflatingSubject : public Subject
+{
+public:
+	/** Creates a new instance, which emits items on the given Scheduler. */
+	explicit ConflatingSubject(const Scheduler& scheduler = Scheduler::messageThread());
+	
+private:
+	JUCE_LEAK_DETECTOR(ConflatingSubject)
+};
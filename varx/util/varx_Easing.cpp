@@ -0,0 +1,59 @@
+/*
+  ==============================================================================
+    
+    varx_Easing.cpp
+    Created: 19 Oct 2026 11:41:52pm
+    Author:  Martin Finke
+  
+  ==============================================================================
+*/
+
+namespace {
+	double linearEasing(double t)
+	{
+		return t;
+	}
+	
+	double easeInEasing(double t)
+	{
+		return t * t;
+	}
+	
+	double easeOutEasing(double t)
+	{
+		return t * (2.0 - t);
+	}
+	
+	double easeInOutEasing(double t)
+	{
+		return (t < 0.5 ? 2.0 * t * t : -1.0 + (4.0 - 2.0 * t) * t);
+	}
+}
+
+Easing::Easing(const std::function<double(double)>& function)
+: function(function) {}
+
+Easing Easing::linear()
+{
+	return Easing(linearEasing);
+}
+
+Easing Easing::easeIn()
+{
+	return Easing(easeInEasing);
+}
+
+Easing Easing::easeOut()
+{
+	return Easing(easeOutEasing);
+}
+
+Easing Easing::easeInOut()
+{
+	return Easing(easeInOutEasing);
+}
+
+double Easing::operator()(double progress) const
+{
+	return function(jlimit(0.0, 1.0, progress));
+}
@@ -0,0 +1,47 @@
+/*
+  ==============================================================================
+    
+    varx_Easing.h
+    Created: 19 Oct 2026 11:41:52pm
+    Author:  Martin Finke
+  
+  ==============================================================================
+*/
+
+#pragma once
+
+namespace varx {
+
+/**
+	Maps the progress of an animation (from 0 to 1) to the proportion of the way from the start value to the target value (also from 0 to 1).
+ 
+	@see Observable::tweenTo
+ */
+class Easing
+{
+public:
+	/** Creates an Easing which calls the given function. The function should return 0 for 0 and 1 for 1. */
+	Easing(const std::function<double(double)>& function);
+	
+	/** Moves at a constant speed. */
+	static Easing linear();
+	
+	/** Starts slowly and accelerates. */
+	static Easing easeIn();
+	
+	/** Starts quickly and decelerates. */
+	static Easing easeOut();
+	
+	/** Starts slowly, accelerates until the middle, and then decelerates. */
+	static Easing easeInOut();
+	
+	/** Returns the proportion for the given progress. */
+	double operator()(double progress) const;
+	
+private:
+	std::function<double(double)> function;
+	
+	JUCE_LEAK_DETECTOR(Easing)
+};
+
+}
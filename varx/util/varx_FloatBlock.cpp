@@ -0,0 +1,278 @@
+/*
+  ==============================================================================
+    
+    varx_FloatBlock.cpp
+    Created: 19 Oct 2026 11:02:17am
+    Author:  Martin Finke
+  
+  ==============================================================================
+*/
+
+namespace {
+	// Processes the samples in 4 independent lanes, so that the compiler can vectorise the loop even without -ffast-math.
+	template<typename Accumulate, typename Combine>
+	float reduceSamples(const float* samples, int numSamples, float initialValue, Accumulate accumulate, Combine combine)
+	{
+		if (numSamples <= 0)
+			return 0;
+		
+		float lanes[4] = {initialValue, initialValue, initialValue, initialValue};
+		int i = 0;
+		
+		for (; i + 4 <= numSamples; i += 4) {
+			lanes[0] = accumulate(lanes[0], samples[i]);
+			lanes[1] = accumulate(lanes[1], samples[i + 1]);
+			lanes[2] = accumulate(lanes[2], samples[i + 2]);
+			lanes[3] = accumulate(lanes[3], samples[i + 3]);
+		}
+		
+		for (; i < numSamples; ++i)
+			lanes[0] = accumulate(lanes[0], samples[i]);
+		
+		return combine(combine(lanes[0], lanes[1]), combine(lanes[2], lanes[3]));
+	}
+	
+	float addKernel(float a, float b)
+	{
+		return a + b;
+	}
+	
+	float minimumKernel(float a, float b)
+	{
+		return (b < a ? b : a);
+	}
+	
+	float maximumKernel(float a, float b)
+	{
+		return (b > a ? b : a);
+	}
+}
+
+
+#pragma mark - FloatBlock
+
+FloatBlock::Storage::Storage(int capacity)
+: data(static_cast<size_t>(capacity), true),
+  capacity(capacity),
+  numSamples(capacity) {}
+
+FloatBlock::FloatBlock() {}
+
+FloatBlock::FloatBlock(int capacity)
+: storage(new Storage(capacity))
+{
+	jassert(capacity >= 0);
+}
+
+FloatBlock::FloatBlock(Storage* storage)
+: storage(storage) {}
+
+bool FloatBlock::isNull() const
+{
+	return storage == nullptr;
+}
+
+int FloatBlock::getNumSamples() const
+{
+	return (storage != nullptr ? storage->numSamples : 0);
+}
+
+int FloatBlock::getCapacity() const
+{
+	return (storage != nullptr ? storage->capacity : 0);
+}
+
+void FloatBlock::setNumSamples(int numSamples)
+{
+	jassert(storage != nullptr);
+	jassert(isPositiveAndNotGreaterThan(numSamples, storage->capacity));
+	
+	storage->numSamples = jlimit(0, storage->capacity, numSamples);
+}
+
+const float* FloatBlock::getReadPointer() const
+{
+	return (storage != nullptr ? storage->data.getData() : nullptr);
+}
+
+float* FloatBlock::getWritePointer()
+{
+	return (storage != nullptr ? storage->data.getData() : nullptr);
+}
+
+void FloatBlock::copyFrom(const float* source, int numSamples)
+{
+	setNumSamples(numSamples);
+	
+	if (storage != nullptr)
+		std::copy(source, source + storage->numSamples, storage->data.getData());
+}
+
+void FloatBlock::clear()
+{
+	if (storage != nullptr)
+		zeromem(storage->data.getData(), sizeof(float) * static_cast<size_t>(storage->capacity));
+}
+
+float FloatBlock::getSum() const
+{
+	return reduceSamples(getReadPointer(), getNumSamples(), 0, addKernel, addKernel);
+}
+
+float FloatBlock::getMin() const
+{
+	const int numSamples = getNumSamples();
+	return (numSamples > 0 ? reduceSamples(getReadPointer(), numSamples, getReadPointer()[0], minimumKernel, minimumKernel) : 0);
+}
+
+float FloatBlock::getMax() const
+{
+	const int numSamples = getNumSamples();
+	return (numSamples > 0 ? reduceSamples(getReadPointer(), numSamples, getReadPointer()[0], maximumKernel, maximumKernel) : 0);
+}
+
+float FloatBlock::getPeak() const
+{
+	return reduceSamples(getReadPointer(), getNumSamples(), 0, [](float peak, float sample) { return maximumKernel(peak, std::abs(sample)); }, maximumKernel);
+}
+
+float FloatBlock::getRMS() const
+{
+	const int numSamples = getNumSamples();
+	if (numSamples == 0)
+		return 0;
+	
+	const float sumOfSquares = reduceSamples(getReadPointer(), numSamples, 0, [](float sum, float sample) { return sum + sample * sample; }, addKernel);
+	return std::sqrt(sumOfSquares / numSamples);
+}
+
+float FloatBlock::getDotProduct(const FloatBlock& other) const
+{
+	const int numSamples = jmin(getNumSamples(), other.getNumSamples());
+	const float* const a = getReadPointer();
+	const float* const b = other.getReadPointer();
+	float lanes[4] = {0, 0, 0, 0};
+	int i = 0;
+	
+	for (; i + 4 <= numSamples; i += 4) {
+		lanes[0] += a[i] * b[i];
+		lanes[1] += a[i + 1] * b[i + 1];
+		lanes[2] += a[i + 2] * b[i + 2];
+		lanes[3] += a[i + 3] * b[i + 3];
+	}
+	
+	for (; i < numSamples; ++i)
+		lanes[0] += a[i] * b[i];
+	
+	return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+
+void FloatBlock::applyGain(float gain)
+{
+	float* const samples = getWritePointer();
+	const int numSamples = getNumSamples();
+	
+	for (int i = 0; i < numSamples; ++i)
+		samples[i] *= gain;
+}
+
+void FloatBlock::applyAbs()
+{
+	float* const samples = getWritePointer();
+	const int numSamples = getNumSamples();
+	
+	for (int i = 0; i < numSamples; ++i)
+		samples[i] = std::abs(samples[i]);
+}
+
+FloatBlock FloatBlock::withGain(float gain, FloatBlockPool& pool) const
+{
+	jassert(pool.getBlockSize() >= getNumSamples());
+	
+	FloatBlock result = pool.allocate();
+	result.setNumSamples(getNumSamples());
+	
+	const float* const source = getReadPointer();
+	float* const destination = result.getWritePointer();
+	const int numSamples = result.getNumSamples();
+	
+	for (int i = 0; i < numSamples; ++i)
+		destination[i] = source[i] * gain;
+	
+	return result;
+}
+
+FloatBlock FloatBlock::withAbs(FloatBlockPool& pool) const
+{
+	jassert(pool.getBlockSize() >= getNumSamples());
+	
+	FloatBlock result = pool.allocate();
+	result.setNumSamples(getNumSamples());
+	
+	const float* const source = getReadPointer();
+	float* const destination = result.getWritePointer();
+	const int numSamples = result.getNumSamples();
+	
+	for (int i = 0; i < numSamples; ++i)
+		destination[i] = std::abs(source[i]);
+	
+	return result;
+}
+
+bool FloatBlock::operator==(const FloatBlock& other) const
+{
+	return storage == other.storage;
+}
+
+bool FloatBlock::operator!=(const FloatBlock& other) const
+{
+	return !(*this == other);
+}
+
+
+#pragma mark - FloatBlockPool
+
+FloatBlockPool::FloatBlockPool(int blockSize, int numBlocksToPreallocate)
+: blockSize(blockSize),
+  nextBlockIndex(0)
+{
+	jassert(blockSize >= 0);
+	
+	blocks.ensureStorageAllocated(numBlocksToPreallocate);
+	for (int i = 0; i < numBlocksToPreallocate; ++i)
+		blocks.add(new FloatBlock::Storage(blockSize));
+}
+
+FloatBlock FloatBlockPool::allocate()
+{
+	const SpinLock::ScopedLockType sl(lock);
+	
+	// A block is free if the pool holds the only reference to it. Start searching after the most recently allocated block, so that the search is short in steady state.
+	const int numBlocks = blocks.size();
+	for (int i = 0; i < numBlocks; ++i) {
+		const int index = (nextBlockIndex + i) % numBlocks;
+		FloatBlock::Storage* const storage = blocks.getObjectPointerUnchecked(index);
+		
+		if (storage->getReferenceCount() == 1) {
+			nextBlockIndex = (index + 1) % numBlocks;
+			storage->numSamples = storage->capacity;
+			return FloatBlock(storage);
+		}
+	}
+	
+	// All blocks are in use
+	FloatBlock::Storage* const storage = blocks.add(new FloatBlock::Storage(blockSize));
+	nextBlockIndex = 0;
+	return FloatBlock(storage);
+}
+
+int FloatBlockPool::getBlockSize() const
+{
+	return blockSize;
+}
+
+int FloatBlockPool::getNumBlocks() const
+{
+	const SpinLock::ScopedLockType sl(lock);
+	return blocks.size();
+}
@@ -0,0 +1,168 @@
+/*
+  ==============================================================================
+    
+    varx_FloatBlock.h
+    Created: 19 Oct 2026 11:02:17am
+    Author:  Martin Finke
+  
+  ==============================================================================
+*/
+
+#pragma once
+
+namespace varx {
+
+class FloatBlockPool;
+
+/**
+	A block of float samples, for moving audio-rate data through Observables one block at a time.
+ 
+	A FloatBlock is a cheap handle to reference-counted storage: Copying it (or wrapping it into a var using toVar) doesn't copy the samples. The storage is freed (or returned to its FloatBlockPool) when the last FloatBlock referring to it is destroyed.
+ 
+		FloatBlockPool pool(512);
+		PublishSubject blocks;
+ 
+		// In the producer:
+		FloatBlock block = pool.allocate();
+		block.copyFrom(buffer.getReadPointer(0), buffer.getNumSamples());
+		blocks.onNext(toVar(block));
+ 
+		// In the consumer:
+		blocks.map([](var v) { return fromVar<FloatBlock>(v).getNumSamples(); });
+ 
+	Because the samples are shared, **you should treat a FloatBlock as immutable once you have emitted it.** Write the samples first, then emit the block.
+ 
+	@see FloatBlockPool
+ */
+class FloatBlock
+{
+public:
+	/** Creates a null FloatBlock, without any storage. */
+	FloatBlock();
+	
+	/** Allocates a new FloatBlock which can hold up to `capacity` samples. Its initial number of samples is `capacity`, and the samples are cleared. If you need many blocks, use a FloatBlockPool instead. */
+	explicit FloatBlock(int capacity);
+	
+	/** Returns true if the FloatBlock has no storage. */
+	bool isNull() const;
+	
+	/** Returns the number of samples in the block. */
+	int getNumSamples() const;
+	
+	/** Returns the maximum number of samples that the block can hold. */
+	int getCapacity() const;
+	
+	/** Changes the number of samples in the block, without reallocating. `numSamples` must not exceed the capacity. */
+	void setNumSamples(int numSamples);
+	
+	/** Returns a pointer to the samples. */
+	const float* getReadPointer() const;
+	
+	/** Returns a writable pointer to the samples. */
+	float* getWritePointer();
+	
+	/** Sets the number of samples to `numSamples` and copies the given samples into the block. `numSamples` must not exceed the capacity. */
+	void copyFrom(const float* source, int numSamples);
+	
+	/** Sets all samples to zero. */
+	void clear();
+	
+	/**
+		@name Kernels
+	 
+		Block-wise operations, to process a whole block per item instead of mapping every sample:
+	 
+			blocks.map([](var v) { return fromVar<FloatBlock>(v).getPeak(); })
+	 
+		The loops are written so that the compiler can vectorise them. Except for getDotProduct, they only consider the first getNumSamples() samples, and return 0 for an empty block.
+	 */
+	///@{
+	/** Returns the sum of all samples. */
+	float getSum() const;
+	
+	/** Returns the smallest sample. */
+	float getMin() const;
+	
+	/** Returns the largest sample. */
+	float getMax() const;
+	
+	/** Returns the largest absolute value of all samples. */
+	float getPeak() const;
+	
+	/** Returns the root mean square of the samples. */
+	float getRMS() const;
+	
+	/** Returns the dot product with another block. If the blocks have a different number of samples, the extra samples are ignored. */
+	float getDotProduct(const FloatBlock& other) const;
+	
+	/** Multiplies all samples by `gain`, in place. Only use this before emitting the block. */
+	void applyGain(float gain);
+	
+	/** Replaces all samples by their absolute value, in place. Only use this before emitting the block. */
+	void applyAbs();
+	
+	/** Returns a new block from `pool`, containing the samples of this block multiplied by `gain`. This block isn't changed, so you can use this in Observable::map. */
+	FloatBlock withGain(float gain, FloatBlockPool& pool) const;
+	
+	/** Returns a new block from `pool`, containing the absolute values of the samples of this block. This block isn't changed, so you can use this in Observable::map. */
+	FloatBlock withAbs(FloatBlockPool& pool) const;
+	///@}
+	
+	/** Returns true if both FloatBlocks refer to the same storage. */
+	bool operator==(const FloatBlock& other) const;
+	/** Returns true if the FloatBlocks refer to different storage. */
+	bool operator!=(const FloatBlock& other) const;
+	
+private:
+	struct Storage : public juce::ReferenceCountedObject
+	{
+		explicit Storage(int capacity);
+		
+		juce::HeapBlock<float> data;
+		const int capacity;
+		int numSamples;
+		
+		JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Storage)
+	};
+	
+	friend class FloatBlockPool;
+	friend struct juce::VariantConverter<FloatBlock>;
+	
+	explicit FloatBlock(Storage* storage);
+	
+	juce::ReferenceCountedObjectPtr<Storage> storage;
+};
+
+
+/**
+	Recycles FloatBlocks of a fixed capacity, so that a stream of blocks doesn't allocate in steady state.
+ 
+	FloatBlockPool::allocate returns a block that isn't referenced anywhere else. When all FloatBlocks (and vars) referring to a block have been destroyed, the block becomes available again. New storage is only allocated if all blocks are in use.
+ 
+	The pool can be used from multiple threads. Blocks that are still in use stay valid when the pool is destroyed.
+ */
+class FloatBlockPool
+{
+public:
+	/** Creates a pool for blocks which can hold up to `blockSize` samples. `numBlocksToPreallocate` blocks are allocated upfront. */
+	explicit FloatBlockPool(int blockSize, int numBlocksToPreallocate = 0);
+	
+	/** Returns a FloatBlock which isn't used anywhere else. Its number of samples is the block size. **The samples are not cleared**, call FloatBlock::clear if you need that. */
+	FloatBlock allocate();
+	
+	/** Returns the capacity of the blocks in the pool. */
+	int getBlockSize() const;
+	
+	/** Returns the number of blocks that the pool has allocated so far (in use or not). */
+	int getNumBlocks() const;
+	
+private:
+	const int blockSize;
+	juce::ReferenceCountedArray<FloatBlock::Storage> blocks;
+	int nextBlockIndex;
+	juce::SpinLock lock;
+	
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FloatBlockPool)
+};
+
+}
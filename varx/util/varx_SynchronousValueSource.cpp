@@ -0,0 +1,26 @@
+/*
+  ==============================================================================
+    
+    varx_SynchronousValueSource.cpp
+    Created: 19 Oct 2026 9:12:40am
+    Author:  Martin Finke
+  
+  ==============================================================================
+*/
+
+SynchronousValueSource::SynchronousValueSource(const var& initialValue)
+: value(initialValue) {}
+
+var SynchronousValueSource::getValue() const
+{
+	return value;
+}
+
+void SynchronousValueSource::setValue(const var& newValue)
+{
+	if (newValue.equalsWithSameType(value))
+		return;
+	
+	value = newValue;
+	sendChangeMessage(true);
+}
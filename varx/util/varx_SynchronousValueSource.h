@@ -0,0 +1,44 @@
+/*
+  ==============================================================================
+    
+    varx_SynchronousValueSource.h
+    Created: 19 Oct 2026 9:12:40am
+    Author:  Martin Finke
+  
+  ==============================================================================
+*/
+
+#pragma once
+
+namespace varx {
+
+/**
+	A juce::Value::ValueSource which notifies its listeners **synchronously**, on the thread that calls Value::setValue.
+ 
+	A normal juce::Value notifies its listeners asynchronously, through the message loop. So Observable::fromValue and Reactive<Value> emit the new value later, and skip values that are set just before they're destroyed. If you use a SynchronousValueSource instead, they emit the new value immediately:
+ 
+		Reactive<Value> gain(Value(new SynchronousValueSource(0.5)));
+		gain.setValue(0.7); // gain.rx.subject emits 0.7 before setValue returns
+ 
+	Setting a value that is equal to the current value (and has the same type) doesn't notify the listeners, so redundant writes don't cause any work downstream.
+ 
+	**If you call setValue on a background thread, the listeners are called on that thread.**
+ */
+class SynchronousValueSource : public juce::Value::ValueSource
+{
+public:
+	/** Creates a new instance with a given initial value. */
+	explicit SynchronousValueSource(const juce::var& initialValue = juce::var());
+	
+	///@cond INTERNAL
+	juce::var getValue() const override;
+	void setValue(const juce::var& newValue) override;
+	///@endcond
+	
+private:
+	juce::var value;
+	
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SynchronousValueSource)
+};
+
+}
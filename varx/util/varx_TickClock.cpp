@@ -0,0 +1,133 @@
+/*
+  ==============================================================================
+    
+    varx_TickClock.cpp
+    Created: 19 Oct 2026 11:04:26pm
+    Author:  Martin Finke
+  
+  ==============================================================================
+*/
+
+/**
+	A listener, together with a lock that's held while it's called. Listeners are called outside of the clock's lock, from a copy of the registrations. So a listener that's removed during a tick is marked as removed, and skipped.
+ */
+struct TickClock::Registration
+{
+	explicit Registration(Listener* listener)
+	: listener(listener),
+	  isRemoved(false) {}
+	
+	Listener* const listener;
+	CriticalSection lock;
+	bool isRemoved;
+};
+
+juce_ImplementSingleton(TickClock)
+
+TickClock::TickClock() {}
+
+TickClock::~TickClock()
+{
+	stopTimer();
+	clearSingletonInstance();
+}
+
+void TickClock::callOnNextTick(const std::function<void()>& f)
+{
+	const ScopedLock sl(lock);
+	pendingFunctions.push_back(f);
+	
+	if (!isTimerRunning())
+		startTimerHz(ticksPerSecond);
+}
+
+void TickClock::addListener(Listener* listener)
+{
+	const ScopedLock sl(lock);
+	
+	for (auto& registration : registrations) {
+		if (registration->listener == listener)
+			return;
+	}
+	
+	registrations.push_back(std::make_shared<Registration>(listener));
+	
+	if (!isTimerRunning())
+		startTimerHz(ticksPerSecond);
+}
+
+void TickClock::removeListener(Listener* listener)
+{
+	std::shared_ptr<Registration> removed;
+	
+	{
+		const ScopedLock sl(lock);
+		auto it = std::find_if(registrations.begin(), registrations.end(), [listener](const std::shared_ptr<Registration>& registration) {
+			return registration->listener == listener;
+		});
+		
+		if (it == registrations.end())
+			return;
+		
+		removed = *it;
+		registrations.erase(it);
+	}
+	
+	// Waits if the listener is being called on the message thread right now
+	const ScopedLock sl(removed->lock);
+	removed->isRemoved = true;
+}
+
+double TickClock::getCurrentTime()
+{
+	return Time::getMillisecondCounterHiRes() / 1000.0;
+}
+
+void TickClock::timerCallback()
+{
+	{
+		const ScopedLock sl(lock);
+		
+		// Nothing has happened for a whole tick
+		if (pendingFunctions.empty() && registrations.empty()) {
+			stopTimer();
+			return;
+		}
+	}
+	
+	triggerTick(getCurrentTime());
+}
+
+void TickClock::triggerTick(double tickTime)
+{
+	jassert(MessageManager::getInstance()->isThisTheMessageThread());
+	
+	std::vector<std::function<void()>> functions;
+	std::vector<std::shared_ptr<Registration>> toCall;
+	
+	{
+		const ScopedLock sl(lock);
+		functions.swap(pendingFunctions);
+		
+		// Reuse the capacity of the previous tick's copy, so that ticks don't allocate
+		toCall.swap(registrationsToCall);
+		toCall.assign(registrations.begin(), registrations.end());
+	}
+	
+	// Functions that are added from here are called with the next tick
+	for (auto& f : functions)
+		f();
+	
+	// Without the clock's lock, so listeners can add or remove listeners, and other threads aren't blocked
+	for (auto& registration : toCall) {
+		const ScopedLock sl(registration->lock);
+		
+		if (!registration->isRemoved)
+			registration->listener->newTick(tickTime);
+	}
+	
+	toCall.clear();
+	
+	const ScopedLock sl(lock);
+	toCall.swap(registrationsToCall);
+}
@@ -0,0 +1,87 @@
+/*
+  ==============================================================================
+    
+    varx_TickClock.h
+    Created: 19 Oct 2026 11:04:26pm
+    Author:  Martin Finke
+  
+  ==============================================================================
+*/
+
+#pragma once
+
+namespace varx {
+
+/**
+	Calls functions on the message thread, with the ticks of a shared 60 Hz juce::Timer.
+ 
+	**The ticks are not synchronised with the display's refresh.** JUCE 5.0 has no vblank callback, so this is a free-running timer. Its ticks drift against the display, and have the usual juce::Timer jitter. The "frames" of Scheduler::frame, Observable::sampleOnFrame, Observable::animationFrames and ExtensionBase::setCoalescesUpdatesPerFrame are ticks of this clock.
+ 
+	A function passed to callOnNextTick is called once, with the next tick. All functions that are pending for a tick are called together, so work that's scheduled from different places is done in one go.
+ 
+	A Listener is called with every tick, until it's removed. This is useful for animations, because all running animations are advanced with the same timer callback.
+ 
+	The timer only runs while functions are pending or listeners are added, so an idle TickClock doesn't cost anything.
+ 
+	The shared TickClock is a juce singleton that's deleted at shutdown, together with its timer, pending functions and registrations. So it doesn't outlive the MessageManager.
+ */
+class TickClock : private juce::Timer, private juce::DeletedAtShutdown
+{
+public:
+	/** The number of ticks per second. */
+	static const int ticksPerSecond = 60;
+	
+	~TickClock();
+	
+	/** Returns the shared TickClock, creating it if needed. */
+	juce_DeclareSingleton(TickClock, false)
+	
+	/** Calls `f` on the message thread with the next tick. Can be called from any thread. */
+	void callOnNextTick(const std::function<void()>& f);
+	
+	/** Is called with every tick, on the message thread. */
+	class Listener
+	{
+	public:
+		virtual ~Listener() {}
+		
+		/** Is called with every tick. `tickTime` is the time of the tick in seconds, as returned by juce::Time::getMillisecondCounterHiRes() / 1000. */
+		virtual void newTick(double tickTime) = 0;
+	};
+	
+	/** Calls the given listener with every tick, until it's removed. Can be called from any thread, also from within Listener::newTick. A listener that's added during a tick is called from the next tick on. */
+	void addListener(Listener* listener);
+	
+	/**
+		Stops calling the given listener. Can be called from any thread, also from within Listener::newTick (of this or another listener).
+	 
+		After this returns, the listener isn't called anymore, so it can be deleted. If the message thread is calling the listener at the moment, this waits until the call has returned. So don't call this while holding a lock that the listener needs.
+	 */
+	void removeListener(Listener* listener);
+	
+	/** Returns the current time in seconds, in the same format as the `tickTime` passed to Listener::newTick. */
+	static double getCurrentTime();
+	
+	/**
+		Calls the pending functions and the listeners right away, as if the timer had ticked at `tickTime`. Must be called on the message thread.
+	 
+		This is meant for tests, which can drive animations with exact tick times instead of waiting for the timer.
+	 */
+	void triggerTick(double tickTime);
+	
+private:
+	struct Registration;
+	
+	juce::CriticalSection lock;
+	std::vector<std::function<void()>> pendingFunctions;
+	std::vector<std::shared_ptr<Registration>> registrations;
+	std::vector<std::shared_ptr<Registration>> registrationsToCall;
+	
+	TickClock();
+	
+	void timerCallback() override;
+	
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TickClock)
+};
+
+}
@@ -108,6 +108,9 @@ struct VariantConverter<BorderSize<int>> : public varx::detail::ReferenceCountin
 template<>
 struct VariantConverter<Font> : public varx::detail::ReferenceCountingVariantConverter<Font> {};
 
+template<>
+struct VariantConverter<ValueTree> : public varx::detail::ReferenceCountingVariantConverter<ValueTree> {};
+
 template<>
 struct VariantConverter<Colour> : public varx::detail::ReferenceCountingVariantConverter<Colour> {};
 
@@ -120,6 +123,27 @@ struct VariantConverter<Button::ButtonState> : public varx::detail::EnumVariantC
 template<>
 struct VariantConverter<TextInputTarget::VirtualKeyboardType> : public varx::detail::EnumVariantConverter<TextInputTarget::VirtualKeyboardType> {};
 
+template<>
+struct VariantConverter<varx::FloatBlock>
+{
+	static varx::FloatBlock fromVar(const var& v)
+	{
+		if (v.isUndefined() || v.isVoid() || (v.isObject() && v.getObject() == nullptr))
+			return varx::FloatBlock();
+		
+		// The storage is stored directly, so wrapping a FloatBlock doesn't allocate
+		if (auto storage = dynamic_cast<varx::FloatBlock::Storage *>(v.getObject()))
+			return varx::FloatBlock(storage);
+		
+		throw std::runtime_error("Error unwrapping type from var. Expected: FloatBlock.");
+	}
+	
+	static var toVar(const varx::FloatBlock& block)
+	{
+		return var(block.storage.get());
+	}
+};
+
 template<typename T>
 struct VariantConverter<WeakReference<T>>
 {
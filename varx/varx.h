@@ -27,12 +27,18 @@ END_JUCE_MODULE_DECLARATION
 #include <iostream>
 #include <map>
 #include <memory>
+#include <set>
 #include <type_traits>
 #include <typeinfo>
+#include <unordered_map>
 #include <utility>
 
 
+#include "util/varx_Easing.h"
+#include "util/varx_FloatBlock.h"
 #include "util/varx_PrintFunctions.h"
+#include "util/varx_SynchronousValueSource.h"
+#include "util/varx_TickClock.h"
 
 namespace varx {
 	
@@ -43,7 +49,9 @@ typedef std::exception_ptr Error;
 #include "rx/varx_Observable.h"
 #include "rx/varx_Observer.h"
 #include "rx/varx_Scheduler.h"
+#include "rx/varx_SubjectMap.h"
 #include "rx/varx_Subjects.h"
+#include "rx/varx_Derived.h"
 	
 }
 